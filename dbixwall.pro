@@ -32,8 +32,15 @@ SOURCES += src/main.cpp \
     src/accountmodel.cpp \
     src/types.cpp \
     src/dbixipc.cpp \
+    src/replyparser.cpp \
+    src/ipcconnection.cpp \
+    src/blockcatchup.cpp \
     src/settings.cpp \
-    src/bigint.cpp \
+    src/uint256.cpp \
+    src/fixeddecimal.cpp \
+    src/transactionstore.cpp \
+    src/transactiontable.cpp \
+    src/hexcodec.cpp \
     src/transactionmodel.cpp \
     src/clipboard.cpp \
     src/dbixlog.cpp \
@@ -44,7 +51,10 @@ SOURCES += src/main.cpp \
     src/contractmodel.cpp \
     src/contractinfo.cpp \
     src/eventmodel.cpp \
-    src/filtermodel.cpp
+    src/filtermodel.cpp \
+    src/dubaicoin/keccak.cpp \
+    src/dubaicoin/rlp.cpp \
+    src/dubaicoin/tx.cpp
 
 RESOURCES += qml/qml.qrc
 
@@ -67,8 +77,15 @@ HEADERS += \
     src/accountmodel.h \
     src/types.h \
     src/dbixipc.h \
+    src/replyparser.h \
+    src/ipcconnection.h \
+    src/blockcatchup.h \
     src/settings.h \
-    src/bigint.h \
+    src/uint256.h \
+    src/fixeddecimal.h \
+    src/transactionstore.h \
+    src/transactiontable.h \
+    src/hexcodec.h \
     src/transactionmodel.h \
     src/clipboard.h \
     src/dbixlog.h \
@@ -80,5 +97,7 @@ HEADERS += \
     src/contractinfo.h \
     src/eventmodel.h \
     src/filtermodel.h \
-	src/dubaicoin/keccak.h
+	src/dubaicoin/keccak.h \
+	src/dubaicoin/rlp.h \
+	src/dubaicoin/tx.h
 
@@ -26,12 +26,14 @@
 #include <QDateTime>
 #include <QFile>
 #include <QFileInfo>
+#include <cstring>
 
 namespace Dbixwall {
 
     AccountModel::AccountModel(DbixIPC& ipc, const CurrencyModel& currencyModel) :
         QAbstractListModel(0), fIpc(ipc), fAccountList(), fSelectedAccountRow(-1), fCurrencyModel(currencyModel), fBusy(false)
     {
+        indexAccounts();
         connect(&ipc, &DbixIPC::connectToServerDone, this, &AccountModel::connectToServerDone);
         connect(&ipc, &DbixIPC::getAccountsDone, this, &AccountModel::getAccountsDone);
         connect(&ipc, &DbixIPC::newAccountDone, this, &AccountModel::newAccountDone);
@@ -70,38 +72,23 @@ namespace Dbixwall {
         return result;
     }
 
-    // TODO: optimize with hashmap
+    // addresses in any case, with or without the 0x prefix
     bool AccountModel::containsAccount(const QString& from, const QString& to, int& i1, int& i2) const {
-        i1 = -1;
-        i2 = -1;
-        int i = 0;
-        foreach ( const AccountInfo& a, fAccountList ) {
-            const QString addr = a.value(HashRole).toString().toLower();
-            if ( addr == from ) {
-                i1 = i;
-            }
-
-            if ( addr == to ) {
-                i2 = i;
-            }
-            i++;
-        }
+        i1 = findAccount(from);
+        i2 = findAccount(to);
 
         return (i1 >= 0 || i2 >= 0);
     }
 
     const QString AccountModel::getTotal() const {
-        BigInt::Rossi total;
+        FixedDecimal total;
 
         foreach ( const AccountInfo& info, fAccountList ) {
-            const QVariant balance = info.value(BalanceRole);
-            double dVal = fCurrencyModel.recalculate(balance).toDouble();
-            const QString strVal = QString::number(dVal, 'f', 18);
-            total += Helpers::dbixStrToRossi(strVal);
+            const FixedDecimal balance = FixedDecimal::fromString(info.value(BalanceRole).toString());
+            total += fCurrencyModel.recalculate(balance);
         }
 
-        const QString weiStr = QString(total.toStrDec().data());
-        return Helpers::weiStrToDbixStr(weiStr);
+        return total.toString();
     }
 
     void AccountModel::newAccount(const QString& pw) {
@@ -237,6 +224,7 @@ namespace Dbixwall {
         if ( !hash.isEmpty() ) {
             beginInsertRows(QModelIndex(), index, index);
             fAccountList.append(AccountInfo(hash, "0.00000000000000000", 0));
+            indexAccount(fAccountList.last(), fAccountList.size() - 1);
             endInsertRows();
             DbixLog::logMsg("New account created");
         } else {
@@ -248,6 +236,7 @@ namespace Dbixwall {
         if ( result ) {
             beginRemoveRows(QModelIndex(), index, index);
             fAccountList.removeAt(index);
+            indexAccounts(); // rows shifted and the bloom can't forget
             endRemoveRows();
             DbixLog::logMsg("Account deleted");
         } else {
@@ -274,6 +263,7 @@ namespace Dbixwall {
     void AccountModel::getAccountsDone(const AccountList& list) {
         beginResetModel();
         fAccountList = list;
+        indexAccounts();
         endResetModel();
 
         refreshAccounts();
@@ -281,51 +271,45 @@ namespace Dbixwall {
 
     void AccountModel::refreshAccounts() {
         //qDebug() << "Refreshing accounts\n";
-        int i = 0;
+        QStringList hashes;
         foreach ( const AccountInfo& info, fAccountList ) {
-            const QString& hash = info.value(HashRole).toString();
-            fIpc.refreshAccount(hash, i++);
+            hashes.append(info.value(HashRole).toString());
         }
+        fIpc.refreshAccounts(hashes);
 
         emit totalChanged();
     }
 
     void AccountModel::accountChanged(const AccountInfo& info) {
-        int index = 0;
-        const QString infoHash = info.value(HashRole).toString();
-        foreach ( const AccountInfo& a, fAccountList ) {
-            if ( a.value(HashRole).toString() == infoHash ) {
-                fAccountList[index] = info;
-                const QModelIndex& leftIndex = QAbstractListModel::createIndex(index, 0);
-                const QModelIndex& rightIndex = QAbstractListModel::createIndex(index, 4);
-                emit dataChanged(leftIndex, rightIndex);
-                emit totalChanged();
-                return;
-            }
-            index++;
+        const int index = findAccount(info.value(HashRole).toString());
+        if ( index >= 0 ) {
+            fAccountList[index] = info;
+            const QModelIndex& leftIndex = QAbstractListModel::createIndex(index, 0);
+            const QModelIndex& rightIndex = QAbstractListModel::createIndex(index, 4);
+            emit dataChanged(leftIndex, rightIndex);
+            emit totalChanged();
+            return;
         }
 
         const int len = fAccountList.length();
         beginInsertRows(QModelIndex(), len, len);
         fAccountList.append(info);
+        indexAccount(info, len);
         endInsertRows();
 
         emit totalChanged();
     }
 
-    void AccountModel::newBlock(const QJsonObject& block) {
-        const QJsonArray transactions = block.value("transactions").toArray();
-        const QString miner = block.value("miner").toString("bogus").toLower();
+    void AccountModel::newBlock(const BlockInfo& block) {
+        const QString miner = block.miner();
         int i1, i2;
         if ( containsAccount(miner, "bogus", i1, i2) ) {
             fIpc.refreshAccount(miner, i1);
         }
 
-        foreach ( QJsonValue t, transactions ) {
-            const QJsonObject to = t.toObject();
-            const TransactionInfo info(to);
-            const QString& sender = info.value(SenderRole).toString().toLower();
-            const QString& receiver = info.value(ReceiverRole).toString().toLower();
+        foreach ( const TransactionInfo& info, block.transactions() ) {
+            const QString& sender = info.value(SenderRole).toString();
+            const QString& receiver = info.value(ReceiverRole).toString();
 
             if ( containsAccount(sender, receiver, i1, i2) ) {
                 if ( i1 >= 0 ) {
@@ -341,6 +325,94 @@ namespace Dbixwall {
         emit totalChanged();
     }
 
+    static int hexNibble(QChar c) {
+        const ushort u = c.unicode();
+        if ( u >= '0' && u <= '9' ) {
+            return u - '0';
+        } else if ( u >= 'a' && u <= 'f' ) {
+            return u - 'a' + 10;
+        } else if ( u >= 'A' && u <= 'F' ) {
+            return u - 'A' + 10;
+        }
+
+        return -1;
+    }
+
+    // binary form of an address for the row index, empty if it isn't one
+    static const QByteArray addressKey(const QString& address) {
+        const int start = address.startsWith("0x") || address.startsWith("0X") ? 2 : 0;
+        if ( address.length() - start != 40 ) {
+            return QByteArray();
+        }
+
+        QByteArray result(20, Qt::Uninitialized);
+        const QChar* digits = address.constData() + start;
+        for ( int i = 0; i < 20; i++ ) {
+            const int high = hexNibble(digits[2 * i]);
+            const int low = hexNibble(digits[2 * i + 1]);
+            if ( high < 0 || low < 0 ) {
+                return QByteArray();
+            }
+            result[i] = (char)(high << 4 | low);
+        }
+
+        return result;
+    }
+
+    // two 12 bit bloom positions read straight off the last six hex digits
+    static bool bloomBits(const QString& address, int& bit1, int& bit2) {
+        const int length = address.length();
+        if ( length < 40 ) {
+            return false;
+        }
+
+        const QChar* tail = address.constData() + length - 6;
+        int bits[2] = { 0, 0 };
+        for ( int i = 0; i < 6; i++ ) {
+            const int nibble = hexNibble(tail[i]);
+            if ( nibble < 0 ) {
+                return false;
+            }
+            bits[i / 3] = bits[i / 3] << 4 | nibble;
+        }
+
+        bit1 = bits[0];
+        bit2 = bits[1];
+        return true;
+    }
+
+    int AccountModel::findAccount(const QString& address) const {
+        int bit1, bit2;
+        if ( !bloomBits(address, bit1, bit2) ||
+             !(fAccountBloom[bit1 / 64] & Q_UINT64_C(1) << (bit1 % 64)) ||
+             !(fAccountBloom[bit2 / 64] & Q_UINT64_C(1) << (bit2 % 64)) ) {
+            return -1; // most of the block's transactions end here
+        }
+
+        return fAccountRows.value(addressKey(address), -1);
+    }
+
+    void AccountModel::indexAccount(const AccountInfo& info, int row) {
+        const QString address = info.value(HashRole).toString();
+        const QByteArray key = addressKey(address);
+        int bit1, bit2;
+        if ( key.isEmpty() || !bloomBits(address, bit1, bit2) ) {
+            return;
+        }
+
+        fAccountRows.insert(key, row); // duplicates resolve to the last row, as the old scan did
+        fAccountBloom[bit1 / 64] |= Q_UINT64_C(1) << (bit1 % 64);
+        fAccountBloom[bit2 / 64] |= Q_UINT64_C(1) << (bit2 % 64);
+    }
+
+    void AccountModel::indexAccounts() {
+        fAccountRows.clear();
+        memset(fAccountBloom, 0, sizeof(fAccountBloom));
+        for ( int i = 0; i < fAccountList.size(); i++ ) {
+            indexAccount(fAccountList.at(i), i);
+        }
+    }
+
     int AccountModel::getSelectedAccountRow() const {
         return fSelectedAccountRow;
     }
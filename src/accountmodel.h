@@ -65,7 +65,7 @@ namespace Dbixwall {
         void newAccountDone(const QString& hash, int index);
         void deleteAccountDone(bool result, int index);
         void accountChanged(const AccountInfo& info);
-        void newBlock(const QJsonObject& block);
+        void newBlock(const BlockInfo& block);
         void currencyChanged();
         void syncingChanged(bool syncing);
         void importWalletDone();
@@ -79,6 +79,8 @@ namespace Dbixwall {
     private:
         DbixIPC& fIpc;
         AccountList fAccountList;
+        QHash<QByteArray, int> fAccountRows; // 20 byte address -> row
+        quint64 fAccountBloom[64]; // 4096 bit prefilter over the address tails
         int fSelectedAccountRow;
         QString fSelectedAccount;
         const CurrencyModel& fCurrencyModel;
@@ -87,6 +89,9 @@ namespace Dbixwall {
         int getSelectedAccountRow() const;
         void setSelectedAccountRow(int row);
         const QString getSelectedAccount() const;
+        int findAccount(const QString& address) const;
+        void indexAccount(const AccountInfo& info, int row);
+        void indexAccounts();
     };
 
 }
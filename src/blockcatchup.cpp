@@ -0,0 +1,235 @@
+/*
+    This file is part of dbixwall.
+    dbixwall is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    dbixwall is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with dbixwall. If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file blockcatchup.cpp
+ * @date 2026
+ *
+ * Missed block catch-up
+ */
+
+#include "blockcatchup.h"
+#include "replyparser.h"
+#include "helpers.h"
+#include "dbixlog.h"
+#include <QSettings>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+namespace Dbixwall {
+
+// *************************** BlockScanTask **************************** //
+
+    BlockScanTask::BlockScanTask(BlockCatchUp& engine, quint64 number, const QByteArray& reply) :
+        QRunnable(), fEngine(engine), fNumber(number), fReply(reply)
+    {
+    }
+
+    void BlockScanTask::run() {
+        BlockInfo block;
+        if ( !ReplyParser(fReply).parseBlock(block) ) { // error reply, null or undecodable, not a miss
+            return fEngine.scanFailed(fNumber);
+        }
+
+        const QSet<QString>& addresses = fEngine.addresses();
+        bool found = addresses.contains(block.miner().toLower());
+        foreach ( const TransactionInfo& info, block.transactions() ) {
+            if ( found ) {
+                break;
+            }
+
+            found = addresses.contains(info.value(SenderRole).toString().toLower()) ||
+                    addresses.contains(info.value(ReceiverRole).toString().toLower());
+        }
+
+        fEngine.scanned(fNumber, block, found);
+    }
+
+// *************************** BlockCatchUp **************************** //
+
+    BlockCatchUp::BlockCatchUp(QObject* parent) :
+        QObject(parent), fConnections(), fInFlight(), fPool(), fMutex(), fScanned(), fAddresses(),
+        fNextFetch(0), fNextMerge(0), fToBlock(0), fDepth(4), fWindow(0), fRunning(false)
+    {
+    }
+
+    BlockCatchUp::~BlockCatchUp() {
+        stop();
+    }
+
+    void BlockCatchUp::start(const QString& path, quint64 fromBlock, quint64 toBlock, const QStringList& addresses) {
+        stop();
+
+        const QSettings settings;
+        const int connections = qBound(1, settings.value("ipc/catchupconnections", 3).toInt(), 8);
+        fDepth = qMax(1, settings.value("ipc/catchupdepth", 4).toInt());
+        fWindow = connections * fDepth * 4; // bounds fetched but not yet merged blocks
+
+        fAddresses.clear();
+        foreach ( const QString& address, addresses ) {
+            fAddresses.insert(address.toLower());
+        }
+
+        fNextFetch = fromBlock;
+        fNextMerge = fromBlock;
+        fToBlock = toBlock;
+        fRunning = true;
+        DbixLog::logMsg("Catching up on blocks " + QString::number(fromBlock) + " to " + QString::number(toBlock), LS_Info);
+
+        for ( int i = 0; i < connections; i++ ) {
+            IPCConnection* connection = new IPCConnection(path, this);
+            connect(connection, &IPCConnection::opened, this, &BlockCatchUp::onOpened);
+            connect(connection, &IPCConnection::frameReceived, this, &BlockCatchUp::onFrame);
+            connect(connection, &IPCConnection::failed, this, &BlockCatchUp::onFailed);
+            fConnections.append(connection);
+            fInFlight[connection] = 0;
+            connection->open();
+        }
+    }
+
+    void BlockCatchUp::stop() {
+        fRunning = false;
+        foreach ( IPCConnection* connection, fConnections ) {
+            connection->close();
+            connection->deleteLater();
+        }
+
+        fConnections.clear();
+        fInFlight.clear();
+        fPool.waitForDone(); // tasks call back into us
+
+        QMutexLocker locker(&fMutex);
+        fScanned.clear();
+    }
+
+    bool BlockCatchUp::isRunning() const {
+        return fRunning;
+    }
+
+    const QSet<QString>& BlockCatchUp::addresses() const {
+        return fAddresses;
+    }
+
+    // called from the pool threads
+    void BlockCatchUp::scanned(quint64 number, const BlockInfo& block, bool found) {
+        {
+            QMutexLocker locker(&fMutex);
+            fScanned.insert(number, found ? block : BlockInfo());
+        }
+
+        QMetaObject::invokeMethod(this, "merge", Qt::QueuedConnection);
+    }
+
+    // called from the pool threads, fails the whole run so the range is retried from
+    // the stored block instead of stepping past this one
+    void BlockCatchUp::scanFailed(quint64 number) {
+        QMetaObject::invokeMethod(this, "onFailed", Qt::QueuedConnection,
+                                  Q_ARG(QString, "unable to decode block " + QString::number(number)));
+    }
+
+    void BlockCatchUp::onOpened() {
+        fill(qobject_cast<IPCConnection*>(sender()));
+    }
+
+    void BlockCatchUp::onFrame(const QByteArray& frame) {
+        IPCConnection* connection = qobject_cast<IPCConnection*>(sender());
+        if ( !fRunning || !fInFlight.contains(connection) ) {
+            return;
+        }
+
+        fInFlight[connection]--;
+        const int number = ReplyParser::callID(frame); // we use block numbers as call IDs
+        if ( number < 0 ) {
+            return onFailed("Catch-up got an invalid reply");
+        }
+
+        fPool.start(new BlockScanTask(*this, number, frame));
+        fill(connection);
+    }
+
+    void BlockCatchUp::onFailed(const QString& error) {
+        if ( !fRunning ) {
+            return;
+        }
+
+        stop();
+        emit failed("Catch-up failed: " + error);
+    }
+
+    void BlockCatchUp::merge() {
+        if ( !fRunning ) {
+            return;
+        }
+
+        const quint64 start = fNextMerge;
+        while ( fNextMerge <= fToBlock ) {
+            BlockInfo block;
+            {
+                QMutexLocker locker(&fMutex);
+                if ( !fScanned.contains(fNextMerge) ) {
+                    break;
+                }
+                block = fScanned.take(fNextMerge);
+            }
+
+            if ( block.number() > 0 ) {
+                emit blockFound(block);
+            }
+            fNextMerge++;
+        }
+
+        if ( fNextMerge == start ) {
+            return;
+        }
+
+        if ( fNextMerge > fToBlock ) {
+            stop();
+            DbixLog::logMsg("Caught up to block " + QString::number(fToBlock), LS_Info);
+            emit finished(fToBlock);
+            return;
+        }
+
+        emit progress(fNextMerge - 1, fToBlock);
+
+        // window moved, top up the connections
+        foreach ( IPCConnection* connection, fConnections ) {
+            fill(connection);
+        }
+    }
+
+    void BlockCatchUp::fill(IPCConnection* connection) {
+        if ( !fRunning || connection == NULL || !connection->isOpen() ) {
+            return;
+        }
+
+        while ( fInFlight.value(connection) < fDepth && fNextFetch <= fToBlock && fNextFetch - fNextMerge < (quint64)fWindow ) {
+            QJsonArray params;
+            params.append(Helpers::toHexStr(fNextFetch));
+            params.append(true); // get transaction bodies
+
+            QJsonObject request;
+            request.insert("jsonrpc", QJsonValue(QString("2.0")));
+            request.insert("method", QJsonValue(QString("eth_getBlockByNumber")));
+            request.insert("id", QJsonValue((qint64)fNextFetch));
+            request.insert("params", QJsonValue(params));
+
+            if ( !connection->write(QJsonDocument(request).toJson(QJsonDocument::Compact)) ) {
+                return; // failed gets emitted by the connection
+            }
+
+            fInFlight[connection]++;
+            fNextFetch++;
+        }
+    }
+
+}
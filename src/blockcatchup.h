@@ -0,0 +1,93 @@
+/*
+    This file is part of dbixwall.
+    dbixwall is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    dbixwall is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with dbixwall. If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file blockcatchup.h
+ * @date 2026
+ *
+ * Missed block catch-up header
+ */
+
+#ifndef BLOCKCATCHUP_H
+#define BLOCKCATCHUP_H
+
+#include <QObject>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QMutex>
+#include <QMap>
+#include <QSet>
+#include <QList>
+#include "types.h"
+#include "ipcconnection.h"
+
+namespace Dbixwall {
+
+    class BlockCatchUp;
+
+    // decodes one full block reply and keeps it only if it touches our addresses
+    class BlockScanTask: public QRunnable
+    {
+    public:
+        BlockScanTask(BlockCatchUp& engine, quint64 number, const QByteArray& reply);
+        void run();
+    private:
+        BlockCatchUp& fEngine;
+        quint64 fNumber;
+        QByteArray fReply;
+    };
+
+    // fetches a block range over several IPC connections, scans the blocks on a
+    // thread pool and hands the ones touching our addresses back in block order
+    class BlockCatchUp: public QObject
+    {
+        Q_OBJECT
+    public:
+        BlockCatchUp(QObject* parent = 0);
+        virtual ~BlockCatchUp();
+
+        void start(const QString& path, quint64 fromBlock, quint64 toBlock, const QStringList& addresses);
+        void stop();
+        bool isRunning() const;
+        const QSet<QString>& addresses() const;
+        void scanned(quint64 number, const BlockInfo& block, bool found);
+        void scanFailed(quint64 number);
+    signals:
+        void blockFound(const BlockInfo& block) const;
+        void progress(quint64 mergedBlock, quint64 toBlock) const;
+        void finished(quint64 toBlock) const;
+        void failed(const QString& error) const;
+    private slots:
+        void onOpened();
+        void onFrame(const QByteArray& frame);
+        void onFailed(const QString& error);
+        void merge();
+    private:
+        QList<IPCConnection*> fConnections;
+        QMap<IPCConnection*, int> fInFlight;
+        QThreadPool fPool;
+        QMutex fMutex; // guards fScanned
+        QMap<quint64, BlockInfo> fScanned; // scanned blocks waiting to be merged in order, empty ones have number 0
+        QSet<QString> fAddresses;
+        quint64 fNextFetch;
+        quint64 fNextMerge;
+        quint64 fToBlock;
+        int fDepth;
+        int fWindow;
+        bool fRunning;
+
+        void fill(IPCConnection* connection);
+    };
+
+}
+
+#endif // BLOCKCATCHUP_H
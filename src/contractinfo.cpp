@@ -2,6 +2,8 @@
 #include <QRegExp>
 #include <QDebug>
 #include "helpers.h"
+#include "hexcodec.h"
+#include "dubaicoin/keccak.h"
 
 namespace Dbixwall {
 
@@ -158,7 +160,7 @@ namespace Dbixwall {
 
     const QVariant ContractArg::decode(const QString& data, bool inArray) const {
         if ( !inArray && fLength >= 0 ) {
-            ulong size = fLength > 0 ? fLength : decodeInt(data.left(64), false).toUlong();
+            ulong size = fLength > 0 ? fLength : decodeInt(data.left(64)).toUInt64();
 
             QVariantList result;
             for ( ulong i = 1; i <= size; i++ ) {
@@ -175,40 +177,33 @@ namespace Dbixwall {
         }
 
         if ( fBaseType == "uint" || fBaseType == "int" ) {
-            const BigInt::Rossi ival = decodeInt(data, fBaseType.at(0) == 'u');
-            return QString(ival.toStrDec().c_str());
+            return decodeDec(decodeInt(data), fBaseType == "int");
         }
 
         if ( fBaseType == "fixed" || fBaseType == "ufixed" ) {
-            const BigInt::Rossi fval = decodeInt(data, fBaseType.at(0) == 'f');
-
-            int i;
-            BigInt::Rossi twoAtN(2);
-            for ( i = 1; i < fN; i++ ) {
-                twoAtN = twoAtN * 2;
-            }
-
-            const BigInt::Rossi fresult = fval / twoAtN;
-            return QString(fresult.toStrDec().c_str());
+            const UInt256 fval = decodeInt(data);
+            const bool negative = fBaseType == "fixed" && fval.bit(255);
+            const UInt256 fresult = (negative ? -fval : fval) >> fN; // divide by 2^N
+            return negative ? "-" + fresult.toDec() : fresult.toDec();
         }
 
         if ( fBaseType == "string" ) {
             // get byte count
-            ulong bytes = decodeInt(data.left(64), false).toUlong();
-            return QString(QByteArray::fromHex(data.mid(64, bytes * 2).toUtf8()));
+            ulong bytes = decodeInt(data.left(64)).toUInt64();
+            return QString(HexCodec::fromHex(data.mid(64, bytes * 2)));
         }
 
         if ( fBaseType == "bytes" ) {
             // get byte count
             QString hexStr;
             if ( dynamic() ) {
-                ulong bytes = decodeInt(data.left(64), false).toUlong();
+                ulong bytes = decodeInt(data.left(64)).toUInt64();
                 hexStr = data.mid(64, bytes * 2).toUtf8();
             } else { // static bytes array
                 ulong bytes = fM;
                 hexStr = data.left(bytes * 2).toUtf8();
             }
-            const QByteArray raw = QByteArray::fromHex(hexStr.toUtf8());
+            const QByteArray raw = HexCodec::fromHex(hexStr);
             bool isAscii = true;
             foreach ( uchar b, raw ) {
                 if ( b < 32 || b > 126 ) {
@@ -224,8 +219,7 @@ namespace Dbixwall {
        }
 
         if ( fBaseType == "bool" ) {
-            const BigInt::Rossi ival(data.toStdString(), 16);
-            return ival == BigInt::Rossi(1);
+            return decodeInt(data) == UInt256(1);
         }
 
         throw QString(QString("DECODE => Unknown type: ") + fBaseType);
@@ -257,9 +251,7 @@ namespace Dbixwall {
             if ( hexStr.length() == 42 ) {
                 hexStr.remove(0, 2); // remove 0x
             }
-            BigInt::Rossi addrNum(hexStr.toStdString(), 16);
-
-            return encodeInt(addrNum);
+            return encodeInt(UInt256::fromHex(hexStr));
         }
 
         bool ok = false;
@@ -274,8 +266,12 @@ namespace Dbixwall {
             int n = fixedVal.indexOf('.');
             int digits = n > 0 ? fixedVal.length() - n - 1 : 0;
             if ( n > 0 ) fixedVal.remove(n, 1);
-            const BigInt::Rossi fixedRossi(fixedVal.toStdString(), 10);
-            return encode(fixedRossi, digits);
+            const bool negative = fixedVal.startsWith('-');
+            if ( negative ) fixedVal.remove(0, 1);
+            bool ok = false;
+            const UInt256 fixedNum = UInt256::fromDec(fixedVal, &ok);
+            if ( !ok ) throw QString(fName + ": Invalid " + fBaseType + " argument: " + val.toString());
+            return encode(negative ? -fixedNum : fixedNum, digits);
         }
 
         if ( fBaseType == "string" ) {
@@ -317,23 +313,25 @@ namespace Dbixwall {
         return encodeInt(number);
     }
 
-    const QString ContractArg::encode(const BigInt::Rossi& val, int digits) const {
+    const QString ContractArg::encode(const UInt256& val, int digits) const {
         if ( fBaseType != "fixed" && fBaseType != "ufixed" ) {
             throw QString("Invalid argument encode value for " + fBaseType + " expected fixed or ufixed");
         }
 
-        int i;
-        BigInt::Rossi twoAtN(2);
-        for ( i = 1; i < fN; i++ ) {
-            twoAtN = twoAtN * 2;
-        }
+        const bool negative = val.bit(255);
+        const UInt256 magnitude = negative ? -val : val;
 
-        BigInt::Rossi divider(1);
-        for ( i = 0; i < digits; i++ ) {
-            divider = divider * 10;
+        UInt256 divider(1);
+        for ( int i = 0; i < digits; i++ ) {
+            divider *= UInt256(10);
         }
 
-        return encodeInt(val * twoAtN / divider);
+        // val * 2^N / 10^digits, split so the shift doesn't overflow 256 bits for sane inputs
+        UInt256 whole, fraction;
+        UInt256::divMod(magnitude, divider, whole, fraction);
+        const UInt256 result = (whole << fN) + (fraction << fN) / divider;
+
+        return encodeInt(negative ? -result : result);
     }
 
     const QString ContractArg::encode(bool val) const {
@@ -345,38 +343,29 @@ namespace Dbixwall {
         return encodeInt(number);
     }
 
+    // negative numbers go out as 256 bit two's complement
     const QString ContractArg::encodeInt(int number) {
         if ( number < 0 ) {
-            return QString("ff%1").arg(number * -1, 62, 16, QChar('0'));
+            return encodeInt(-UInt256((quint64)(-(qint64)number)));
         }
 
         return QString("%1").arg(number, 64, 16, QChar('0'));
     }
 
-    const QString ContractArg::encodeInt(const BigInt::Rossi& number) {
-        QString strNum;
-        if ( number < BigInt::Rossi(0) ) {
-            strNum = QString((number * BigInt::Rossi(-1)).toStrHex().c_str());
-        } else {
-            strNum = QString((number).toStrHex().c_str());
-        }
-
-        while ( strNum.length() < 64 ) {
-            strNum = "0" + strNum;
-        }
+    const QString ContractArg::encodeInt(const UInt256& number) {
+        return number.toHex(64);
+    }
 
-        return strNum;
+    const UInt256 ContractArg::decodeInt(const QString& data) {
+        return UInt256::fromHex(data);
     }
 
-    const BigInt::Rossi ContractArg::decodeInt(const QString& data, bool isSigned) {
-        QString rawData = data;
-        int multiplier = 1;
-        if ( isSigned && data.at(0) == 'f' && data.at(1) == 'f' ) {
-            rawData.replace(0, 2, '0');
-            multiplier = -1;
+    const QString ContractArg::decodeDec(const UInt256& value, bool isSigned) {
+        if ( isSigned && value.bit(255) ) {
+            return "-" + (-value).toDec();
         }
 
-        return BigInt::Rossi(rawData.toStdString(), 16) * multiplier;
+        return value.toDec();
     }
 
     const QString ContractArg::encodeBytes(QByteArray bytes, int fixedSize) {
@@ -392,7 +381,7 @@ namespace Dbixwall {
             bytes.append('\0');
         }
 
-        return sizePrefix + bytes.toHex();
+        return sizePrefix + HexCodec::toHex(bytes);
     }
 
     const QRegExp ContractArg::getValRex() const {
@@ -465,7 +454,7 @@ namespace Dbixwall {
         }
 
         fSignature = buildSignature();
-        fMethodID = QString(QCryptographicHash::hash(fSignature.toUtf8(), QCryptographicHash::Sha3_256).left(4).toHex());
+        fMethodID = QString(HexCodec::toHex(Dubaicoin::Keccak256::hash(fSignature.toUtf8()).left(4)));
     }
 
     const QString ContractCallable::getArgLiteral(const QJsonValue& arg) const {
@@ -543,7 +532,7 @@ namespace Dbixwall {
     // ***************************** ContractEvent ***************************** //
 
     ContractEvent::ContractEvent(const QJsonObject &source) : ContractCallable(source) {
-        fMethodID = QString(QCryptographicHash::hash(fSignature.toUtf8(), QCryptographicHash::Sha3_256).left(32).toHex());
+        fMethodID = QString(HexCodec::toHex(Dubaicoin::Keccak256::hash(fSignature.toUtf8())));
     }
 
     // ***************************** ContractFunction ***************************** //
@@ -586,6 +575,10 @@ namespace Dbixwall {
 
     // ***************************** EventInfo ***************************** //
 
+    EventInfo::EventInfo() : fBlockNumber(0), fMethodID("invalid")
+    {
+    }
+
     EventInfo::EventInfo(const QJsonObject& source) {
         fBlockNumber = Helpers::toQUInt64(source["blockNumber"]);
         fBlockHash = source["blockHash"].toString();
@@ -597,6 +590,10 @@ namespace Dbixwall {
         foreach ( const QVariant v, topics ) {
             fTopics.append(v.toString());
         }
+        initMethodID();
+    }
+
+    void EventInfo::initMethodID() {
         fMethodID = QString("invalid");
         if ( fTopics.length() > 0 ) {
             fMethodID = fTopics.at(0);
@@ -634,7 +631,7 @@ namespace Dbixwall {
             }
 
             if ( arg.dynamic() ) { // value holds "pointer" to data in data
-                ulong ptr = arg.decodeInt(val, false).toUlong() * 2;
+                ulong ptr = arg.decodeInt(val).toUInt64() * 2;
                 val = data.mid(ptr);
                 fParams.append(arg.decode(val));
             } else { // value is direct
@@ -2,13 +2,12 @@
 #define CONTRACTINFO_H
 
 #include <QVariant>
-#include <QCryptographicHash>
 #include <QAbstractListModel>
 #include <QStringList>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonDocument>
-#include "bigint.h"
+#include "uint256.h"
 
 #include <QDebug>
 
@@ -65,15 +64,16 @@ namespace Dbixwall {
         const QString encode(const QVariant& val, bool inArray = false) const;
         static const QString encodeBytes(QByteArray bytes, int fixedSize = 0);
         static const QString encodeInt(int number);
-        static const QString encodeInt(const BigInt::Rossi& number);
+        static const QString encodeInt(const UInt256& number);
         bool dynamic() const;
         const QVariant decode(const QString& data, bool inArray = false) const;
-        static const BigInt::Rossi decodeInt(const QString& data, bool isSigned);
+        static const UInt256 decodeInt(const QString& data);
+        static const QString decodeDec(const UInt256& value, bool isSigned);
     private:
         const QString encode(const QString& text) const;
         const QString encode(const QByteArray& bytes) const;
         const QString encode(int number) const;
-        const QString encode(const BigInt::Rossi& val, int digits) const;
+        const QString encode(const UInt256& val, int digits) const;
         const QString encode(bool val) const;
         const QRegExp getValRex() const;
         const QString getPlaceholder() const;
@@ -149,6 +149,7 @@ namespace Dbixwall {
     class EventInfo
     {
     public:
+        EventInfo();
         EventInfo(const QJsonObject& source);
 
         void fillContract(const ContractInfo& contract);
@@ -175,6 +176,9 @@ namespace Dbixwall {
         QStringList fTopics;
         ContractArgs fArguments;
         QVariantList fParams;
+
+        void initMethodID();
+        friend class ReplyParser;
     };
 
     typedef QList<EventInfo> EventList;
@@ -267,7 +267,7 @@ namespace Dbixwall {
         settings.endGroup();
     }
 
-    void ContractModel::onNewEvent(const QJsonObject& event, bool isNew) {
+    void ContractModel::onNewEvent(const EventInfo& event, bool isNew) {
         EventInfo info(event);
 
         // find the right contract and process/fill the params
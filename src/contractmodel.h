@@ -69,7 +69,7 @@ namespace Dbixwall {
         void busyChanged(bool busy) const;
     public slots:
         void reload();
-        void onNewEvent(const QJsonObject& event, bool isNew);
+        void onNewEvent(const EventInfo& event, bool isNew);
         void httpRequestDone(QNetworkReply *reply);
     private:
         const QString getPostfix() const;
@@ -69,8 +69,15 @@ namespace Dbixwall {
             return dbix; // no change
         }
 
-        double val = fCurrencies.at(fIndex).recalculate(dbix.toDouble());
-        return QVariant(QString::number(val, 'f', 18));
+        return QVariant(recalculate(FixedDecimal::fromString(dbix.toString())).toString());
+    }
+
+    const FixedDecimal CurrencyModel::recalculate(const FixedDecimal& dbix) const {
+        if ( fIndex == 0 ) {
+            return dbix; // no change
+        }
+
+        return fCurrencies.at(fIndex).recalculate(dbix);
     }
 
     int CurrencyModel::getCount() const {
@@ -79,7 +86,7 @@ namespace Dbixwall {
 
     void CurrencyModel::loadCurrencies() {
         fCurrencies.clear();
-        fCurrencies.append(CurrencyInfo("DBIX", 1.0));
+        fCurrencies.append(CurrencyInfo("DBIX", FixedDecimal::fromInteger(1)));
 
         // get currency data from dbixdata
         QNetworkRequest request(QUrl("https://data.dbixwall.com/api/currencies"));
@@ -128,7 +135,12 @@ namespace Dbixwall {
 
         foreach ( const QJsonValue p, d ) {
             const QString key = p.toObject().value("Symbol").toString("bogus");
-            const float value = p.toObject().value("Price").toVariant().toFloat(0);
+            const QJsonValue price = p.toObject().value("Price");
+            bool ok = false;
+            FixedDecimal value = FixedDecimal::fromString(price.toVariant().toString(), &ok);
+            if ( !ok ) { // exponent notation for tiny prices
+                value = FixedDecimal::fromString(QString::number(price.toDouble(0), 'f', FixedDecimal::DECIMALS));
+            }
             fCurrencies.append(CurrencyInfo(key, value));
         }
 
@@ -151,7 +163,7 @@ namespace Dbixwall {
 
     double CurrencyModel::getCurrencyPrice(int index) const {
         if ( fCurrencies.size() > index && index >= 0 ) {
-            return fCurrencies.at(index).recalculate(1.0);
+            return fCurrencies.at(index).value(PriceRole).toDouble();
         }
 
         return 1.0;
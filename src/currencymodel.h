@@ -43,6 +43,7 @@ namespace Dbixwall {
         int rowCount(const QModelIndex & parent = QModelIndex()) const;
         QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const;
         QVariant recalculate(const QVariant dbix) const;
+        const FixedDecimal recalculate(const FixedDecimal& dbix) const;
         int getCount() const;
         Q_INVOKABLE QString getCurrencyName(int index = -1) const;
         Q_INVOKABLE void loadCurrencies();
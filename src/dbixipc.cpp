@@ -20,8 +20,10 @@
 
 #include "dbixipc.h"
 #include "helpers.h"
+#include "replyparser.h"
 #include <QSettings>
 #include <QFileInfo>
+#include <QCoreApplication>
 
 // windblows hacks coz windblows sucks
 #ifdef Q_OS_WIN32
@@ -43,7 +45,7 @@ namespace Dbixwall {
     {
     }
 
-    RequestIPC::RequestIPC(RequestBurden burden) : fBurden(burden)
+    RequestIPC::RequestIPC(RequestBurden burden) : fCallID(-1), fType(NoRequest), fIndex(-1), fBurden(burden)
     {
     }
 
@@ -71,13 +73,442 @@ namespace Dbixwall {
         return fBurden;
     }
 
+    RequestPriority RequestIPC::priority() const {
+        switch ( fType ) {
+        case NewAccount:
+        case DeleteAccount:
+        case SendTransaction:
+        case UnlockAccount:
+        case EstimateGas:
+        case GetTransactionReceipt: return Interactive;
+        default: break;
+        }
+
+        return fBurden == NonVisual ? Background : Regular;
+    }
+
+    bool RequestIPC::sameCall(const RequestIPC& other) const {
+        return fType == other.fType && fIndex == other.fIndex && sameResult(other);
+    }
+
+    bool RequestIPC::sameResult(const RequestIPC& other) const {
+        return fMethod == other.fMethod && fParams == other.fParams;
+    }
+
+    // long running historical queries, routed to the bulk connections
+    bool RequestIPC::bulk() const {
+        return fType == GetLogs;
+    }
+
+    const QJsonObject RequestIPC::toJson() const {
+        QJsonObject result;
+
+        result.insert("jsonrpc", QJsonValue(QString("2.0")));
+        result.insert("method", QJsonValue(fMethod));
+        result.insert("id", QJsonValue(fCallID));
+        result.insert("params", QJsonValue(fParams));
+
+        return result;
+    }
+
+    // reads without side effects on the node, safe to answer several callers with one reply
+    bool RequestIPC::idempotent() const {
+        switch ( fType ) {
+        case GetBlockNumber:
+        case GetAccountRefs:
+        case GetBalance:
+        case GetTransactionCount:
+        case GetPeerCount:
+        case GetGasPrice:
+        case GetTransactionByHash:
+        case GetBlock:
+        case GetClientVersion:
+        case GetNetVersion:
+        case GetSyncing:
+        case GetTransactionReceipt: return true;
+        default: break;
+        }
+
+        return false;
+    }
+
+// *************************** RequestScheduler **************************** //
+
+    RequestScheduler::RequestScheduler()
+    {
+        for ( int i = 0; i < PriorityCount; i++ ) {
+            fTotalWait[i] = 0;
+            fMaxWait[i] = 0;
+            fServed[i] = 0;
+        }
+
+        fClock.start();
+    }
+
+    // returns false if the requests were coalesced with an already queued background poll
+    bool RequestScheduler::enqueue(const RequestList& requests) {
+        const RequestPriority priority = priorityOf(requests);
+
+        if ( priority == Background && requests.size() == 1 ) {
+            foreach ( const RequestList& queued, fQueues[Background] ) {
+                if ( queued.size() == 1 && queued.first().sameCall(requests.first()) ) {
+                    return false;
+                }
+            }
+        }
+
+        fQueues[priority].append(requests);
+        fQueuedAt[priority].append(fClock.elapsed());
+        return true;
+    }
+
+    const RequestList RequestScheduler::dequeue() {
+        for ( int i = 0; i < PriorityCount; i++ ) {
+            if ( !fQueues[i].isEmpty() ) {
+                const qint64 wait = fClock.elapsed() - fQueuedAt[i].takeFirst();
+                fTotalWait[i] += wait;
+                fMaxWait[i] = qMax(fMaxWait[i], wait);
+                fServed[i]++;
+                return fQueues[i].takeFirst();
+            }
+        }
+
+        return RequestList();
+    }
+
+    // finds a queued request giving the same result
+    bool RequestScheduler::find(const RequestIPC& request, RequestIPC& found) const {
+        for ( int i = 0; i < PriorityCount; i++ ) {
+            foreach ( const RequestList& queued, fQueues[i] ) {
+                foreach ( const RequestIPC& other, queued ) {
+                    if ( other.sameResult(request) ) {
+                        found = other;
+                        return true;
+                    }
+                }
+            }
+        }
+
+        return false;
+    }
+
+    bool RequestScheduler::isEmpty() const {
+        for ( int i = 0; i < PriorityCount; i++ ) {
+            if ( !fQueues[i].isEmpty() ) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void RequestScheduler::clear() {
+        for ( int i = 0; i < PriorityCount; i++ ) {
+            fQueues[i].clear();
+            fQueuedAt[i].clear();
+        }
+    }
+
+    int RequestScheduler::depth(RequestPriority priority) const {
+        return fQueues[priority].size();
+    }
+
+    qint64 RequestScheduler::averageWait(RequestPriority priority) const {
+        return fServed[priority] > 0 ? fTotalWait[priority] / fServed[priority] : 0;
+    }
+
+    qint64 RequestScheduler::maxWait(RequestPriority priority) const {
+        return fMaxWait[priority];
+    }
+
+    const QString RequestScheduler::stats() const {
+        static const char* names[PriorityCount] = { "interactive", "regular", "background" };
+        QStringList result;
+
+        for ( int i = 0; i < PriorityCount; i++ ) {
+            const RequestPriority priority = (RequestPriority)i;
+            result.append(QString("%1: depth %2 avg wait %3ms max wait %4ms").arg(names[i]).arg(depth(priority))
+                          .arg(averageWait(priority)).arg(maxWait(priority)));
+        }
+
+        return result.join(", ");
+    }
+
+    // a batch goes out with the most urgent priority of its members
+    RequestPriority RequestScheduler::priorityOf(const RequestList& requests) {
+        RequestPriority result = Background;
+        foreach ( const RequestIPC& request, requests ) {
+            result = qMin(result, request.priority());
+        }
+
+        return result;
+    }
+
+// *************************** IPCResult **************************** //
+
+    IPCResult::IPCResult() : fType(NoResult), fNew(false), fCode(0)
+    {
+    }
+
+    IPCResult::IPCResult(IPCResultType type, const AccountList& accounts) : fType(type), fAccounts(accounts), fNew(false), fCode(0)
+    {
+    }
+
+    IPCResult::IPCResult(const TransactionInfo& transaction) : fType(TransactionResult), fTransaction(transaction), fNew(false), fCode(0)
+    {
+    }
+
+    IPCResult::IPCResult(const BlockInfo& block) : fType(BlockResult), fBlock(block), fNew(false), fCode(0)
+    {
+    }
+
+    IPCResult::IPCResult(const EventInfo& event, bool isNew) : fType(EventResult), fEvent(event), fNew(isNew), fCode(0)
+    {
+    }
+
+    IPCResult::IPCResult(const QString& error, int code) : fType(ErrorResult), fNew(false), fError(error), fCode(code)
+    {
+    }
+
+    IPCResult::IPCResult(const IPCState& state) : fType(StateResult), fNew(false), fCode(0), fState(state)
+    {
+    }
+
+    IPCResult::IPCResult(IPCResultType type) : fType(type), fNew(false), fCode(0)
+    {
+    }
+
+    IPCResult::IPCResult(IPCResultType type, const QString& text, int index) : fType(type), fNew(false), fError(text), fCode(index)
+    {
+    }
+
+    IPCResult::IPCResult(IPCResultType type, bool flag, int index) : fType(type), fNew(flag), fCode(index)
+    {
+    }
+
+    IPCResult::IPCResult(const QJsonObject& receipt) : fType(ReceiptResult), fNew(false), fCode(0), fReceipt(receipt)
+    {
+    }
+
+// *************************** IPCState **************************** //
+
+    IPCState::IPCState() :
+        fStarting(0), fExternal(false), fClosing(false), fConnected(false), fSyncing(false), fPeerCount(0),
+        fClientVersion(), fNetVersion(0), fCurrentBlock(0), fHighestBlock(0), fStartingBlock(0), fBlockNumber(0)
+    {
+    }
+
+// *************************** ResultQueue **************************** //
+
+    ResultQueue::Node::Node(const IPCResult& result) : fResult(result), fNext(0)
+    {
+    }
+
+    ResultQueue::ResultQueue() : fHead(new Node(IPCResult())), fTail(fHead), fCount(0)
+    {
+    }
+
+    ResultQueue::~ResultQueue() {
+        while ( fHead != NULL ) {
+            Node* next = fHead->fNext.loadAcquire();
+            delete fHead;
+            fHead = next;
+        }
+    }
+
+    // producer side, returns true if the consumer went idle and needs a wake up
+    bool ResultQueue::push(const IPCResult& result) {
+        Node* node = new Node(result);
+        fTail->fNext.storeRelease(node);
+        fTail = node;
+
+        // counted only after linking, so the consumer never waits for a node it was told about
+        return fCount.fetchAndAddOrdered(1) == 0;
+    }
+
+    int ResultQueue::count() const {
+        return fCount.loadAcquire();
+    }
+
+    // consumer side
+    bool ResultQueue::pop(IPCResult& result) {
+        Node* next = fHead->fNext.loadAcquire();
+        if ( next == NULL ) {
+            return false;
+        }
+
+        result = next->fResult;
+        next->fResult = IPCResult(); // next becomes the dummy, don't keep the payload around
+        delete fHead;
+        fHead = next;
+        return true;
+    }
+
+    // consumer side, returns true if nothing was pushed meanwhile and the queue went idle
+    bool ResultQueue::release(int count) {
+        return fCount.fetchAndAddOrdered(-count) == count;
+    }
+
+// *************************** ConnectionPool **************************** //
+
+    ConnectionPool::ConnectionPool(QObject* parent) :
+        QObject(parent), fConnections(), fQueues(), fInFlight(), fCalls(), fDepth(1)
+    {
+    }
+
+    void ConnectionPool::open(const QString& path, int size, int depth) {
+        close();
+        fDepth = qMax(1, depth);
+
+        for ( int i = 0; i < size; i++ ) {
+            IPCConnection* connection = new IPCConnection(path, this);
+            connect(connection, &IPCConnection::opened, this, &ConnectionPool::onOpened);
+            connect(connection, &IPCConnection::frameReceived, this, &ConnectionPool::frameReceived);
+            connect(connection, &IPCConnection::failed, this, &ConnectionPool::onFailed);
+            fConnections.append(connection);
+            connection->open();
+        }
+    }
+
+    void ConnectionPool::close() {
+        foreach ( IPCConnection* connection, fConnections ) {
+            connection->disconnect(this);
+            connection->close();
+            connection->deleteLater();
+        }
+
+        fConnections.clear();
+        fQueues.clear();
+        fInFlight.clear();
+        fCalls.clear();
+    }
+
+    // forgets queued and in flight calls but keeps the connections, late replies get dropped by the caller
+    void ConnectionPool::reset() {
+        fQueues.clear();
+        fInFlight.clear();
+        fCalls.clear();
+    }
+
+    bool ConnectionPool::isReady() const {
+        foreach ( IPCConnection* connection, fConnections ) {
+            if ( connection->isOpen() ) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // goes to the least loaded open connection
+    void ConnectionPool::enqueue(const RequestIPC& request) {
+        IPCConnection* best = NULL;
+        int bestLoad = 0;
+        foreach ( IPCConnection* connection, fConnections ) {
+            const int load = fQueues.value(connection).size() + fInFlight.value(connection).size();
+            if ( connection->isOpen() && ( best == NULL || load < bestLoad ) ) {
+                best = connection;
+                bestLoad = load;
+            }
+        }
+
+        if ( best == NULL ) {
+            emit lost(RequestList() << request);
+            return;
+        }
+
+        fQueues[best].append(request);
+        flush(best);
+    }
+
+    // reply for one of ours got handled, frees up its connection
+    void ConnectionPool::finished(int callID) {
+        IPCConnection* connection = fCalls.take(callID);
+        if ( connection == NULL ) {
+            return;
+        }
+
+        RequestList& inFlight = fInFlight[connection];
+        for ( int i = 0; i < inFlight.size(); i++ ) {
+            if ( inFlight.at(i).getCallID() == callID ) {
+                inFlight.removeAt(i);
+                break;
+            }
+        }
+
+        flush(connection);
+    }
+
+    void ConnectionPool::onOpened() {
+        DbixLog::logMsg("Bulk IPC connection ready", LS_Debug);
+        flush(qobject_cast<IPCConnection*>(sender()));
+    }
+
+    // hand everything queued or in flight on the failed connection back for rerouting
+    void ConnectionPool::onFailed(const QString& error) {
+        IPCConnection* connection = qobject_cast<IPCConnection*>(sender());
+        if ( connection == NULL || !fConnections.contains(connection) ) {
+            return;
+        }
+
+        DbixLog::logMsg("Bulk IPC connection failed: " + error, LS_Warning);
+        const RequestList requests = fInFlight.take(connection) + fQueues.take(connection);
+        foreach ( const RequestIPC& request, requests ) {
+            fCalls.remove(request.getCallID());
+        }
+
+        fConnections.removeAll(connection);
+        connection->disconnect(this);
+        connection->deleteLater();
+
+        if ( !requests.isEmpty() ) {
+            emit lost(requests);
+        }
+    }
+
+    void ConnectionPool::flush(IPCConnection* connection) {
+        if ( connection == NULL || !connection->isOpen() ) {
+            return;
+        }
+
+        RequestList& queue = fQueues[connection];
+        RequestList& inFlight = fInFlight[connection];
+        while ( !queue.isEmpty() && inFlight.size() < fDepth ) {
+            const RequestIPC request = queue.first();
+            const QByteArray data = QJsonDocument(request.toJson()).toJson(QJsonDocument::Compact);
+            DbixLog::logMsg("Sent (bulk): " + QString::fromUtf8(data), LS_Debug);
+
+            if ( !connection->write(data) ) {
+                return; // failed takes care of the requests
+            }
+
+            queue.removeFirst();
+            inFlight.append(request);
+            fCalls.insert(request.getCallID(), connection);
+            emit written(request);
+        }
+    }
+
+// *************************** ResultDispatcher **************************** //
+
+    ResultDispatcher::ResultDispatcher(DbixIPC& ipc) : QObject(0), fIpc(ipc)
+    {
+    }
+
+    void ResultDispatcher::drain() {
+        fIpc.drainResults();
+    }
+
 // *************************** DbixIPC **************************** //
 
     DbixIPC::DbixIPC(const QString& ipcPath, GdbixLog& gdbixLog) :
-        fPath(ipcPath), fBlockFilterID(), fClosingApp(false), fPeerCount(0), fActiveRequest(None),
-        fGdbix(), fStarting(0), fGdbixLog(gdbixLog),
+        fPath(ipcPath), fResults(), fDispatcher(*this), fBusy(0), fShownError(), fShownCode(0), fShownState(), fSocket(this),
+        fBlockFilterID(), fClosingApp(false), fPeerCount(0), fReplyFailed(false), fActiveRequest(None), fPipelineDepth(1),
+        fTimer(this), fNetVersion(0), fGdbix(this), fStarting(0), fGdbixLog(gdbixLog),
         fSyncing(false), fCurrentBlock(0), fHighestBlock(0), fStartingBlock(0),
-        fConnectAttempts(0), fKillTime(), fExternal(false), fEventFilterID()
+        fConnectAttempts(0), fKillTime(), fExternal(false), fEventFilterID(),
+        fBlockSubscribed(false), fEventSubscribed(false), fSubscribe(true), fBlockNumber(0), fCatchUp(this), fLiveBlock(0), fStoredBlock(0),
+        fBulkPool(this), fBulkRequests()
     {
         connect(&fSocket, (void (QLocalSocket::*)(QLocalSocket::LocalSocketError))&QLocalSocket::error, this, &DbixIPC::onSocketError);
         connect(&fSocket, &QLocalSocket::readyRead, this, &DbixIPC::onSocketReadyRead);
@@ -87,20 +518,44 @@ namespace Dbixwall {
 
         const QSettings settings;
 
+        // amount of requests written to the socket before waiting for replies, 1 means strictly serial
+        fPipelineDepth = qMax(1, settings.value("ipc/pipeline", 8).toInt());
+        // push new heads and logs via eth_subscribe, filter polling is used if the node can't
+        fSubscribe = settings.value("ipc/subscriptions", true).toBool();
+
         //fTimer.setInterval(settings.value("ipc/interval", 10).toInt() * 1000);
         connect(&fTimer, &QTimer::timeout, this, &DbixIPC::onTimer);
+
+        connect(&fCatchUp, &BlockCatchUp::blockFound, this, &DbixIPC::onCatchUpBlock);
+        connect(&fCatchUp, &BlockCatchUp::progress, this, &DbixIPC::onCatchUpProgress);
+        connect(&fCatchUp, &BlockCatchUp::finished, this, &DbixIPC::onCatchUpFinished);
+        connect(&fCatchUp, &BlockCatchUp::failed, this, &DbixIPC::onCatchUpFailed);
+
+        connect(&fBulkPool, &ConnectionPool::frameReceived, this, &DbixIPC::onBulkFrame);
+        connect(&fBulkPool, &ConnectionPool::written, this, &DbixIPC::onBulkWritten);
+        connect(&fBulkPool, &ConnectionPool::lost, this, &DbixIPC::onBulkLost);
     }
 
     DbixIPC::~DbixIPC() {
         fGdbix.kill();
     }
 
-    void DbixIPC::init() {        
+    // socket, timer and gdbix process are our children so they move along
+    void DbixIPC::setWorker(QThread* worker) {
+        moveToThread(worker);
+    }
+
+    void DbixIPC::init() {
+        if ( offThread() ) {
+            QMetaObject::invokeMethod(this, "init", Qt::QueuedConnection);
+            return;
+        }
+
         fConnectAttempts = 0;
         if ( fStarting <= 0 ) { // try to connect without starting gdbix
             DbixLog::logMsg("Dbixwall starting", LS_Info);
             fStarting = 1;
-            emit startingChanged(fStarting);
+            publishState();
             return connectToServer();
         }
 
@@ -124,7 +579,7 @@ namespace Dbixwall {
         QFileInfo info(progStr);
         if ( !info.exists() || !info.isExecutable() ) {
             fStarting = -1;
-            emit startingChanged(-1);
+            publishState();
             setError("Could not find Gdbix. Please check Gdbix path and try again.");
             return bail();
         }
@@ -134,7 +589,7 @@ namespace Dbixwall {
 
         fGdbixLog.attach(&fGdbix);
         fGdbix.start(progStr, args);
-        emit startingChanged(0);
+        publishState();
     }
 
     void DbixIPC::waitConnect() {
@@ -158,8 +613,14 @@ namespace Dbixwall {
     }
 
     void DbixIPC::connectToServer() {
+        if ( offThread() ) {
+            QMetaObject::invokeMethod(this, "connectToServer", Qt::QueuedConnection);
+            return;
+        }
+
         fActiveRequest = RequestIPC(Full);
-        emit busyChanged(getBusy());
+        fFrameReader.clear(); // leftovers from previous connection
+        publishBusy();
         if ( fSocket.state() != QLocalSocket::UnconnectedState ) {
             setError("Already connected");
             return bail();
@@ -185,12 +646,19 @@ namespace Dbixwall {
         newBlockFilter();
         getNetVersion();
 
+        // eth_getLogs and such get their own connections so they never hold up the main one
+        const QSettings settings;
+        const int bulkConnections = qBound(0, settings.value("ipc/bulkconnections", 1).toInt(), 4);
+        if ( bulkConnections > 0 ) {
+            fBulkPool.open(fPath, bulkConnections, fPipelineDepth);
+        }
+
         if ( fStarting == 1 ) {
             fExternal = true;
-            emit externalChanged(true);
             fGdbixLog.append("Attached to external gdbix, see logs in terminal window.");
         }
         fStarting = 3;
+        publishState();
         DbixLog::logMsg("Connected to IPC socket");
     }
 
@@ -204,19 +672,23 @@ namespace Dbixwall {
     }
 
     bool DbixIPC::getBusy() const {
-        return (fActiveRequest.burden() != None);
+        return fBusy.loadAcquire() != 0;
+    }
+
+    bool DbixIPC::isBusy() const {
+        return (fActiveRequest.burden() != None || !fPendingRequests.isEmpty() || !fBulkRequests.isEmpty());
     }
 
     bool DbixIPC::getExternal() const {
-        return fExternal;
+        return fShownState.fExternal;
     }
 
     bool DbixIPC::getStarting() const {
-        return (fStarting == 1 || fStarting == 2);
+        return (fShownState.fStarting == 1 || fShownState.fStarting == 2);
     }
 
     bool DbixIPC::getClosing() const {
-        return fClosingApp;
+        return fShownState.fClosing;
     }
 
     /*bool DbixIPC::getHardForkReady() const {
@@ -225,11 +697,11 @@ namespace Dbixwall {
     }*/
 
     const QString& DbixIPC::getError() const {
-        return fError;
+        return fShownError;
     }
 
     int DbixIPC::getCode() const {
-        return fCode;
+        return fShownCode;
     }
 
 
@@ -238,17 +710,26 @@ namespace Dbixwall {
     }*/
 	
 	void DbixIPC::setInterval(int interval) {
+        if ( offThread() ) {
+            QMetaObject::invokeMethod(this, "setInterval", Qt::QueuedConnection, Q_ARG(int, interval));
+            return;
+        }
+
         QSettings settings;
         settings.setValue("ipc/interval", (int) (interval / 1000));
         fTimer.setInterval(interval);
     }
 
     bool DbixIPC::getTestnet() const {
-        return fNetVersion == 4;
+        return fShownState.fNetVersion == 4;
+    }
+
+    const QString& DbixIPC::getClientVersion() const {
+        return fShownState.fClientVersion;
     }
 	
 	const QString DbixIPC::getNetworkPostfix() const {
-        return Helpers::networkPostfix(fNetVersion);
+        return Helpers::networkPostfix(fShownState.fNetVersion);
     }
 
     /*const QString DbixIPC::getNetworkPostfix() const {
@@ -288,25 +769,31 @@ namespace Dbixwall {
     }
 
     bool DbixIPC::closeApp() {
+        if ( offThread() ) {
+            bool result = false;
+            QMetaObject::invokeMethod(this, "closeApp", Qt::BlockingQueuedConnection, Q_RETURN_ARG(bool, result));
+            return result;
+        }
+
         DbixLog::logMsg("Closing dbixwall");
         fClosingApp = true;
         fTimer.stop();
-        emit closingChanged(true);
+        publishState();
 
-        if ( fSocket.state() == QLocalSocket::ConnectedState && getBusy() ) { // wait for operation first if we're still connected
+        if ( fSocket.state() == QLocalSocket::ConnectedState && isBusy() ) { // wait for operation first if we're still connected
             return false;
         }
 
         if ( fSocket.state() == QLocalSocket::ConnectedState ) {
             bool removed = false;
             if ( !fBlockFilterID.isEmpty() ) { // remove block filter if still connected
-                uninstallFilter(fBlockFilterID);
+                uninstallFilter(fBlockFilterID, fBlockSubscribed);
                 fBlockFilterID.clear();
                 removed = true;
             }
 
             if ( !fEventFilterID.isEmpty() ) { // remove event filter if still connected
-                uninstallFilter(fEventFilterID);
+                uninstallFilter(fEventFilterID, fEventSubscribed);
                 fEventFilterID.clear();
                 removed = true;
             }
@@ -316,6 +803,8 @@ namespace Dbixwall {
             }
         }
 
+        fBulkPool.close();
+
         if ( fSocket.state() != QLocalSocket::UnconnectedState ) { // wait for clean disconnect
             fActiveRequest = RequestIPC(Full);
             fSocket.disconnectFromServer();
@@ -325,9 +814,35 @@ namespace Dbixwall {
         return killGdbix();
     }
 
+    // last call before the IPC thread quits, tears our children down on the thread owning them
+    // and hands us back to the GUI thread for destruction
+    void DbixIPC::shutdown() {
+        if ( offThread() ) {
+            QMetaObject::invokeMethod(this, "shutdown", Qt::BlockingQueuedConnection);
+            return;
+        }
+
+        fClosingApp = true; // the abort below is expected
+        fTimer.stop();
+        fCatchUp.stop();
+        fBulkPool.close();
+        fSocket.abort();
+        if ( fGdbix.state() != QProcess::NotRunning ) {
+            fGdbix.kill();
+            fGdbix.waitForFinished(1000);
+        }
+
+        moveToThread(QCoreApplication::instance()->thread());
+    }
+
     void DbixIPC::registerEventFilters(const QStringList& addresses, const QStringList& topics) {
+        if ( offThread() ) {
+            QMetaObject::invokeMethod(this, "registerEventFilters", Qt::QueuedConnection, Q_ARG(QStringList, addresses), Q_ARG(QStringList, topics));
+            return;
+        }
+
         if ( !fEventFilterID.isEmpty() ) {
-            uninstallFilter(fEventFilterID);
+            uninstallFilter(fEventFilterID, fEventSubscribed);
             fEventFilterID.clear();
         }
 
@@ -337,6 +852,12 @@ namespace Dbixwall {
     }
 
     void DbixIPC::loadLogs(const QStringList& addresses, const QStringList& topics, quint64 fromBlock) {
+        if ( offThread() ) {
+            QMetaObject::invokeMethod(this, "loadLogs", Qt::QueuedConnection, Q_ARG(QStringList, addresses), Q_ARG(QStringList, topics),
+                                      Q_ARG(quint64, fromBlock));
+            return;
+        }
+
         if ( addresses.length() > 0 ) {
             getLogs(addresses, topics, fromBlock);
         }
@@ -352,6 +873,11 @@ namespace Dbixwall {
     }
 
     void DbixIPC::getAccounts() {
+        if ( offThread() ) {
+            QMetaObject::invokeMethod(this, "getAccounts", Qt::QueuedConnection);
+            return;
+        }
+
         fAccountList.clear();
         if ( !queueRequest(RequestIPC(GetAccountRefs, "personal_listAccounts", QJsonArray())) ) {
             return bail();
@@ -364,17 +890,25 @@ namespace Dbixwall {
             return bail();
         }
 
-        QJsonArray refs = jv.toArray();
-        foreach( QJsonValue r, refs ) {
-            const QString hash = r.toString("INVALID");
+        QStringList hashes;
+        foreach( QJsonValue r, jv.toArray() ) {
+            hashes.append(r.toString("INVALID"));
+        }
+
+        // checksummed in one batch, AccountInfo then hits the address cache
+        foreach ( const QString& hash, Helpers::vitalizeAddresses(hashes) ) {
             fAccountList.append(AccountInfo(hash, QString(), 0));
         }
 
-        emit getAccountsDone(fAccountList);
+        postResult(IPCResult(AccountsResult, fAccountList));
         done();
     }
 
     bool DbixIPC::refreshAccount(const QString& hash, int index) {
+        if ( offThread() ) {
+            return QMetaObject::invokeMethod(this, "refreshAccount", Qt::QueuedConnection, Q_ARG(QString, hash), Q_ARG(int, index));
+        }
+
         if ( getBalance(hash, index) ) {
             return getTransactionCount(hash, index);
         }
@@ -382,7 +916,40 @@ namespace Dbixwall {
         return false;
     }
 
+    bool DbixIPC::refreshAccounts(const QStringList& hashes) {
+        if ( offThread() ) {
+            return QMetaObject::invokeMethod(this, "refreshAccounts", Qt::QueuedConnection, Q_ARG(QStringList, hashes));
+        }
+
+        if ( hashes.isEmpty() ) {
+            return true;
+        }
+
+        // all balances and nonces go out in one JSON-RPC batch, replies get dispatched one by one
+        RequestList batch;
+        int index = 0;
+        foreach ( const QString& hash, hashes ) {
+            QJsonArray params;
+            params.append(hash);
+            params.append(QString("latest"));
+            batch.append(RequestIPC(GetBalance, "eth_getBalance", params, index));
+            batch.append(RequestIPC(GetTransactionCount, "eth_getTransactionCount", params, index));
+            index++;
+        }
+
+        if ( !queueBatch(batch) ) {
+            bail();
+            return false;
+        }
+
+        return true;
+    }
+
     bool DbixIPC::getBalance(const QString& hash, int index) {
+        if ( offThread() ) {
+            return QMetaObject::invokeMethod(this, "getBalance", Qt::QueuedConnection, Q_ARG(QString, hash), Q_ARG(int, index));
+        }
+
         QJsonArray params;
         params.append(hash);
         params.append(QString("latest"));
@@ -395,6 +962,10 @@ namespace Dbixwall {
     }
 
     bool DbixIPC::getTransactionCount(const QString& hash, int index) {
+        if ( offThread() ) {
+            return QMetaObject::invokeMethod(this, "getTransactionCount", Qt::QueuedConnection, Q_ARG(QString, hash), Q_ARG(int, index));
+        }
+
         QJsonArray params;
         params.append(hash);
         params.append(QString("latest"));
@@ -415,9 +986,12 @@ namespace Dbixwall {
 
         const QString decStr = Helpers::toDecStrDbix(jv);
         const int index = fActiveRequest.getIndex();
+        if ( index < 0 || index >= fAccountList.size() ) { // account list got reloaded while in flight
+            return done();
+        }
         fAccountList[index].setBalance(decStr);
 
-        emit accountChanged(fAccountList.at(index));
+        postResult(IPCResult(AccountResult, AccountList() << fAccountList.at(index)));
         done();
     }
 
@@ -427,17 +1001,23 @@ namespace Dbixwall {
             return bail();
         }
 
-        std::string hexStr = jv.toString("0x0").remove(0, 2).toStdString();
-        const BigInt::Vin bv(hexStr, 16);
-        quint64 count = bv.toUlong();
+        quint64 count = Helpers::toQUInt64(jv);
         const int index = fActiveRequest.getIndex();
+        if ( index < 0 || index >= fAccountList.size() ) { // account list got reloaded while in flight
+            return done();
+        }
         fAccountList[index].setTransactionCount(count);
 
-        emit accountChanged(fAccountList.at(index));
+        postResult(IPCResult(AccountResult, AccountList() << fAccountList.at(index)));
         done();
     }
 
     void DbixIPC::newAccount(const QString& password, int index) {
+        if ( offThread() ) {
+            QMetaObject::invokeMethod(this, "newAccount", Qt::QueuedConnection, Q_ARG(QString, password), Q_ARG(int, index));
+            return;
+        }
+
         QJsonArray params;
         params.append(password);
         if ( !queueRequest(RequestIPC(NewAccount, "personal_newAccount", params, index)) ) {
@@ -452,11 +1032,16 @@ namespace Dbixwall {
         }
 
         const QString result = jv.toString();
-        emit newAccountDone(result, fActiveRequest.getIndex());
+        postResult(IPCResult(NewAccountResult, result, fActiveRequest.getIndex()));
         done();
     }
 
     void DbixIPC::deleteAccount(const QString& hash, const QString& password, int index) {
+        if ( offThread() ) {
+            QMetaObject::invokeMethod(this, "deleteAccount", Qt::QueuedConnection, Q_ARG(QString, hash), Q_ARG(QString, password), Q_ARG(int, index));
+            return;
+        }
+
         QJsonArray params;
         params.append(hash);
         params.append(password);        
@@ -472,11 +1057,16 @@ namespace Dbixwall {
         }
 
         const bool result = jv.toBool(false);
-        emit deleteAccountDone(result, fActiveRequest.getIndex());
+        postResult(IPCResult(DeleteAccountResult, result, fActiveRequest.getIndex()));
         done();
     }
 
     void DbixIPC::getBlockNumber() {
+        if ( offThread() ) {
+            QMetaObject::invokeMethod(this, "getBlockNumber", Qt::QueuedConnection);
+            return;
+        }
+
         if ( !queueRequest(RequestIPC(NonVisual, GetBlockNumber, "eth_blockNumber")) ) {
             return bail();
         }
@@ -489,20 +1079,25 @@ namespace Dbixwall {
         }
 
         fBlockNumber = result;
-        emit getBlockNumberDone(result);
+        publishState();
         done();
     }
 
     quint64 DbixIPC::blockNumber() const {
-        return fBlockNumber;
+        return fShownState.fBlockNumber;
     }
 
 	int DbixIPC::network() const
     {
-        return fNetVersion;
+        return fShownState.fNetVersion;
     }
 	
     void DbixIPC::getPeerCount() {
+        if ( offThread() ) {
+            QMetaObject::invokeMethod(this, "getPeerCount", Qt::QueuedConnection);
+            return;
+        }
+
         if ( !queueRequest(RequestIPC(NonVisual, GetPeerCount, "net_peerCount")) ) {
             return bail();
         }
@@ -513,14 +1108,26 @@ namespace Dbixwall {
              return bail();
         }
 
-        emit peerCountChanged(fPeerCount);
+        publishState();
         done();
     }
 
     void DbixIPC::sendTransaction(const QString& from, const QString& to, const QString& valStr, const QString& password,
                                    const QString& gas, const QString& gasPrice, const QString& data) {
+        if ( offThread() ) {
+            QMetaObject::invokeMethod(this, "sendTransaction", Qt::QueuedConnection, Q_ARG(QString, from), Q_ARG(QString, to), Q_ARG(QString, valStr),
+                                      Q_ARG(QString, password), Q_ARG(QString, gas), Q_ARG(QString, gasPrice), Q_ARG(QString, data));
+            return;
+        }
+
         QJsonArray params;
-        const QString valHex = Helpers::toHexWeiStr(valStr);
+        bool ok = false;
+        const QString valHex = Helpers::toHexWeiStr(valStr, &ok);
+        if ( !ok ) {
+            setError("Invalid transaction value: " + valStr);
+            fCode = 0;
+            return bail(true); // softbail
+        }
         QJsonObject p;
         p["from"] = from;
         p["value"] = valHex;
@@ -528,11 +1135,21 @@ namespace Dbixwall {
             p["to"] = to;
         }
         if ( !gas.isEmpty() ) {
-            const QString gasHex = Helpers::decStrToHexStr(gas);
+            const QString gasHex = Helpers::decStrToHexStr(gas, &ok);
+            if ( !ok ) {
+                setError("Invalid gas: " + gas);
+                fCode = 0;
+                return bail(true);
+            }
             p["gas"] = gasHex;
         }
         if ( !gasPrice.isEmpty() ) {
-            const QString gasPriceHex = Helpers::toHexWeiStr(gasPrice);
+            const QString gasPriceHex = Helpers::toHexWeiStr(gasPrice, &ok);
+            if ( !ok ) {
+                setError("Invalid gas price: " + gasPrice);
+                fCode = 0;
+                return bail(true);
+            }
             p["gasPrice"] = gasPriceHex;
             DbixLog::logMsg(QString("Trans gasPrice: ") + gasPrice + QString(" HexValue: ") + gasPriceHex);
         }
@@ -555,12 +1172,12 @@ namespace Dbixwall {
         }
 
         const QString hash = jv.toString();
-        emit sendTransactionDone(hash);
+        postResult(IPCResult(SendTransactionResult, hash, -1));
         done();
     }
 
     int DbixIPC::getConnectionState() const {
-        if ( fSocket.state() == QLocalSocket::ConnectedState ) {
+        if ( fShownState.fConnected ) {
             return 1; // TODO: add higher states per peer count!
         }
 
@@ -568,13 +1185,17 @@ namespace Dbixwall {
     }
 
     void DbixIPC::unlockAccount(const QString& hash, const QString& password, int duration, int index) {
+        if ( offThread() ) {
+            QMetaObject::invokeMethod(this, "unlockAccount", Qt::QueuedConnection, Q_ARG(QString, hash), Q_ARG(QString, password),
+                                      Q_ARG(int, duration), Q_ARG(int, index));
+            return;
+        }
+
         QJsonArray params;
         params.append(hash);
         params.append(password);
 
-        BigInt::Vin vinVal(duration);
-        QString strHex = QString(vinVal.toStr0xHex().data());
-        params.append(strHex);
+        params.append(Helpers::toHexStr(duration));
 
         if ( !queueRequest(RequestIPC(UnlockAccount, "personal_unlockAccount", params, index)) ) {
             return bail();
@@ -593,13 +1214,18 @@ namespace Dbixwall {
 
         if ( !result ) {
             setError("Unlock account failure");
-            emit error();
+            publishError();
         }
-        emit unlockAccountDone(result, fActiveRequest.getIndex());
+        postResult(IPCResult(UnlockAccountResult, result, fActiveRequest.getIndex()));
         done();
     }
 
     void DbixIPC::getGasPrice() {
+        if ( offThread() ) {
+            QMetaObject::invokeMethod(this, "getGasPrice", Qt::QueuedConnection);
+            return;
+        }
+
         if ( !queueRequest(RequestIPC(GetGasPrice, "eth_gasPrice")) ) {
             return bail();
         }
@@ -613,12 +1239,12 @@ namespace Dbixwall {
 
         const QString decStr = Helpers::toDecStrDbix(jv);
 
-        emit getGasPriceDone(decStr);
+        postResult(IPCResult(GasPriceResult, decStr, -1));
         done();
     }
 
     quint64 DbixIPC::peerCount() const {
-        return fPeerCount;
+        return fShownState.fPeerCount;
     }
 	
 	void DbixIPC::ipcReady()
@@ -627,14 +1253,25 @@ namespace Dbixwall {
         setInterval(settings.value("ipc/interval", 10).toInt() * 1000); // re-set here, used for inheritance purposes
         fTimer.start(); // should happen after filter creation, might need to move into last filter response handler
         // if we connected to external gdbix, put that info in gdbix log
-        emit startingChanged(fStarting);
-        emit connectToServerDone();
-        emit connectionStateChanged();
+        publishState();
+        postResult(IPCResult(ConnectedResult));
     }
 
     void DbixIPC::estimateGas(const QString& from, const QString& to, const QString& valStr,
                                    const QString& gas, const QString& gasPrice, const QString& data) {
-        const QString valHex = Helpers::toHexWeiStr(valStr);
+        if ( offThread() ) {
+            QMetaObject::invokeMethod(this, "estimateGas", Qt::QueuedConnection, Q_ARG(QString, from), Q_ARG(QString, to), Q_ARG(QString, valStr),
+                                      Q_ARG(QString, gas), Q_ARG(QString, gasPrice), Q_ARG(QString, data));
+            return;
+        }
+
+        bool ok = false;
+        const QString valHex = Helpers::toHexWeiStr(valStr, &ok);
+        if ( !ok ) {
+            setError("Invalid transaction value: " + valStr);
+            fCode = 0;
+            return bail(true);
+        }
         QJsonArray params;
         QJsonObject p;
         p["from"] = from;
@@ -643,11 +1280,21 @@ namespace Dbixwall {
             p["to"] = to;
         }
         if ( !gas.isEmpty() ) {
-            const QString gasHex = Helpers::decStrToHexStr(gas);
+            const QString gasHex = Helpers::decStrToHexStr(gas, &ok);
+            if ( !ok ) {
+                setError("Invalid gas: " + gas);
+                fCode = 0;
+                return bail(true);
+            }
             p["gas"] = gasHex;
         }
         if ( !gasPrice.isEmpty() ) {
-            const QString gasPriceHex = Helpers::toHexWeiStr(gasPrice);
+            const QString gasPriceHex = Helpers::toHexWeiStr(gasPrice, &ok);
+            if ( !ok ) {
+                setError("Invalid gas price: " + gasPrice);
+                fCode = 0;
+                return bail(true);
+            }
             p["gasPrice"] = gasPriceHex;
         }
         if ( !data.isEmpty() ) {
@@ -668,7 +1315,7 @@ namespace Dbixwall {
 
         const QString price = Helpers::toDecStr(jv);
 
-        emit estimateGasDone(price);
+        postResult(IPCResult(EstimateGasResult, price, -1));
 
         done();
     }
@@ -679,20 +1326,41 @@ namespace Dbixwall {
             return bail(true);
         }
 
+        if ( fSubscribe ) {
+            QJsonArray params;
+            params.append(QString("newHeads"));
+
+            if ( !queueRequest(RequestIPC(SubscribeNewHeads, "eth_subscribe", params)) ) {
+                return bail();
+            }
+            return;
+        }
+
         if ( !queueRequest(RequestIPC(NewBlockFilter, "eth_newBlockFilter")) ) {
             return bail();
         }
     }
 
     void DbixIPC::newEventFilter(const QStringList& addresses, const QStringList& topics) {
-        QJsonArray params;
         QJsonObject o;
         o["address"] = QJsonArray::fromStringList(addresses);
         if ( topics.length() > 0 && topics.at(0).length() > 0 ) {
             o["topics"] = QJsonArray::fromStringList(topics);
         }
-        params.append(o);
+        fEventFilterParams = o; // kept in case we need to fall back from subscription
+
+        QJsonArray params;
+        if ( fSubscribe ) {
+            params.append(QString("logs"));
+            params.append(o);
+
+            if ( !queueRequest(RequestIPC(SubscribeLogs, "eth_subscribe", params)) ) {
+                return bail();
+            }
+            return;
+        }
 
+        params.append(o);
         if ( !queueRequest(RequestIPC(NewEventFilter, "eth_newFilter", params)) ) {
             return bail();
         }
@@ -704,6 +1372,7 @@ namespace Dbixwall {
             return bail();
         }
         fBlockFilterID = jv.toString();
+        fBlockSubscribed = false;
 
         if ( fBlockFilterID.isEmpty() ) {
             setError("Block filter ID invalid");
@@ -719,6 +1388,7 @@ namespace Dbixwall {
             return bail();
         }
         fEventFilterID = jv.toString();
+        fEventSubscribed = false;
 
         if ( fEventFilterID.isEmpty() ) {
             setError("Event filter ID invalid");
@@ -728,17 +1398,83 @@ namespace Dbixwall {
         done();
     }
 
+    void DbixIPC::handleSubscribe() {
+        const bool heads = fActiveRequest.getType() == SubscribeNewHeads;
+        QJsonValue jv;
+        if ( !readReply(jv) || jv.toString().isEmpty() ) { // older gdbix or subscriptions disabled on the endpoint
+            DbixLog::logMsg("Subscriptions unavailable, falling back to filter polling: " + fError, LS_Warning);
+            fSubscribe = false;
+
+            if ( heads ) {
+                newBlockFilter();
+            } else {
+                QJsonArray params;
+                params.append(fEventFilterParams);
+                if ( !queueRequest(RequestIPC(NewEventFilter, "eth_newFilter", params)) ) {
+                    return bail();
+                }
+            }
+
+            return done();
+        }
+
+        if ( heads ) {
+            fBlockFilterID = jv.toString();
+            fBlockSubscribed = true;
+        } else {
+            fEventFilterID = jv.toString();
+            fEventSubscribed = true;
+        }
+
+        done();
+    }
+
+    // unsolicited message from one of our subscriptions
+    void DbixIPC::handleNotification(const QString& subscription) {
+        ReplyParser parser(fReply);
+
+        if ( fBlockSubscribed && subscription == fBlockFilterID ) {
+            QString hash;
+            if ( !parser.parseHead(hash) ) {
+                DbixLog::logMsg("Invalid newHeads notification", LS_Warning);
+                return;
+            }
+
+            if ( !fSyncing ) {
+                getBlockByHash(hash); // heads come without transactions
+            }
+            return;
+        }
+
+        if ( fEventSubscribed && subscription == fEventFilterID ) {
+            EventInfo info;
+            if ( !parser.parseLog(info) ) {
+                DbixLog::logMsg("Invalid logs notification", LS_Warning);
+                return;
+            }
+
+            postResult(IPCResult(info, true));
+            return;
+        }
+
+        DbixLog::logMsg("Dropping notification for unknown subscription " + subscription, LS_Debug);
+    }
+
     void DbixIPC::onTimer() {
+        DbixLog::logMsg("IPC queues: " + fRequestQueue.stats(), LS_Debug);
+
         getPeerCount();
         getSyncing();
 
         if ( !fBlockFilterID.isEmpty() && !fSyncing ) {
-            getFilterChanges(fBlockFilterID);
+            if ( !fBlockSubscribed ) {
+                getFilterChanges(fBlockFilterID);
+            }
         } else {
             getBlockNumber();
         }
 
-        if ( !fEventFilterID.isEmpty() ) {
+        if ( !fEventFilterID.isEmpty() && !fEventSubscribed ) {
             getFilterChanges(fEventFilterID);
         }
     }
@@ -762,7 +1498,7 @@ namespace Dbixwall {
     }
 
     void DbixIPC::getFilterChanges(const QString& filterID) {
-        if ( filterID < 0 ) {
+        if ( filterID.isEmpty() ) {
             setError("Filter ID invalid");
             return bail();
         }
@@ -776,27 +1512,24 @@ namespace Dbixwall {
     }
 
     void DbixIPC::handleGetFilterChanges() {
-        QJsonValue jv;
-        if ( !readReply(jv) ) {
-            return bail();
+        QStringList hashes;
+        EventList events;
+        if ( !ReplyParser(fReply).parseFilterChanges(hashes, events) ) {
+            return bailDecode();
         }
 
-        QJsonArray ar = jv.toArray();
+        foreach ( const EventInfo& event, events ) { // event filter result
+            postResult(IPCResult(event, fActiveRequest.getType() == GetFilterChanges)); // get logs is not "new"
+        }
 
-        foreach( const QJsonValue v, ar ) {
-            if ( v.isObject() ) { // event filter result
-                const QJsonObject logs = v.toObject();
-                emit newEvent(logs, fActiveRequest.getType() == GetFilterChanges); // get logs is not "new"
-            } else { // block filter (we don't use transaction filters yet)
-                const QString hash = v.toString("bogus");
-                getBlockByHash(hash);
-            }
+        foreach ( const QString& hash, hashes ) { // block filter (we don't use transaction filters yet)
+            getBlockByHash(hash);
         }
 
         done();
     }
 
-    void DbixIPC::uninstallFilter(const QString& filter) {
+    void DbixIPC::uninstallFilter(const QString& filter, bool subscription) {
         if ( filter.isEmpty() ) {
             setError("Filter not set");
             return bail(true);
@@ -807,7 +1540,8 @@ namespace Dbixwall {
         QJsonArray params;
         params.append(filter);
 
-        if ( !queueRequest(RequestIPC(UninstallFilter, "eth_uninstallFilter", params)) ) {
+        const QString method = subscription ? "eth_unsubscribe" : "eth_uninstallFilter";
+        if ( !queueRequest(RequestIPC(UninstallFilter, method, params)) ) {
             return bail();
         }
     }
@@ -850,22 +1584,27 @@ namespace Dbixwall {
     }
 
     bool DbixIPC::getSyncingVal() const {
-        return fSyncing;
+        return fShownState.fSyncing;
     }
 
     quint64 DbixIPC::getCurrentBlock() const {
-        return fCurrentBlock;
+        return fShownState.fCurrentBlock;
     }
 
     quint64 DbixIPC::getHighestBlock() const {
-        return fHighestBlock;
+        return fShownState.fHighestBlock;
     }
 
     quint64 DbixIPC::getStartingBlock() const {
-        return fStartingBlock;
+        return fShownState.fStartingBlock;
     }
 
     void DbixIPC::getTransactionByHash(const QString& hash) {
+        if ( offThread() ) {
+            QMetaObject::invokeMethod(this, "getTransactionByHash", Qt::QueuedConnection, Q_ARG(QString, hash));
+            return;
+        }
+
         QJsonArray params;
         params.append(hash);
 
@@ -875,16 +1614,27 @@ namespace Dbixwall {
     }
 
     void DbixIPC::handleGetTransactionByHash() {
-        QJsonValue jv;
-        if ( !readReply(jv) ) {
-            return bail();
+        TransactionInfo info;
+        if ( !ReplyParser(fReply).parseTransaction(info) ) {
+            QJsonValue jv;
+            if ( !readReply(jv) ) {
+                return bail();
+            }
+
+            return done(); // not known to the node (yet), nothing to update
         }
 
-        emit newTransaction(TransactionInfo(jv.toObject()));
+        info.lookupAccountAliases();
+        postResult(IPCResult(info));
         done();
     }
 
     void DbixIPC::getBlockByHash(const QString& hash) {
+        if ( offThread() ) {
+            QMetaObject::invokeMethod(this, "getBlockByHash", Qt::QueuedConnection, Q_ARG(QString, hash));
+            return;
+        }
+
         QJsonArray params;
         params.append(hash);
         params.append(true); // get transaction bodies
@@ -895,6 +1645,11 @@ namespace Dbixwall {
     }
 
     void DbixIPC::getBlockByNumber(quint64 blockNum) {
+        if ( offThread() ) {
+            QMetaObject::invokeMethod(this, "getBlockByNumber", Qt::QueuedConnection, Q_ARG(quint64, blockNum));
+            return;
+        }
+
         QJsonArray params;
         params.append(Helpers::toHexStr(blockNum));
         params.append(true); // get transaction bodies
@@ -905,19 +1660,108 @@ namespace Dbixwall {
     }
 
     void DbixIPC::handleGetBlock() {
-        QJsonValue jv;
-        if ( !readReply(jv) ) {
-            return bail();
+        BlockInfo block;
+        if ( !ReplyParser(fReply).parseBlock(block) ) {
+            return bailDecode();
         }
 
-        const QJsonObject block = jv.toObject();
-        const quint64 num = Helpers::toQUInt64(block.value("number"));
-        emit getBlockNumberDone(num);
-        emit newBlock(block);
+        fBlockNumber = block.number();
+        publishState();
+        postResult(IPCResult(block));
+        trackBlock(block.number());
         done();
     }
 
+    // a gap to the last block we've processed means we missed blocks while closed or syncing
+    void DbixIPC::trackBlock(quint64 number) {
+        if ( number == 0 || number <= fLiveBlock || fNetVersion <= 0 ) {
+            return; // pending, already seen or we don't know the network yet
+        }
+
+        if ( fLiveBlock == 0 ) {
+            fStoredBlock = storedLastBlock();
+        }
+
+        const quint64 last = fLiveBlock > 0 ? fLiveBlock : fStoredBlock;
+        fLiveBlock = number;
+
+        if ( fCatchUp.isRunning() ) {
+            return; // stored once the catch-up is done
+        }
+
+        if ( last > 0 && number > last + 1 && !fAccountList.isEmpty() ) {
+            QStringList addresses;
+            foreach ( const AccountInfo& info, fAccountList ) {
+                addresses.append(info.value(HashRole).toString());
+            }
+
+            fCatchUp.start(fPath, last + 1, number - 1, addresses);
+            return;
+        }
+
+        storeLastBlock(number);
+    }
+
+    quint64 DbixIPC::storedLastBlock() const {
+        const QSettings settings;
+        return settings.value("blocks/last" + Helpers::networkPostfix(fNetVersion), 0).toULongLong();
+    }
+
+    void DbixIPC::storeLastBlock(quint64 number) {
+        QSettings settings;
+        settings.setValue("blocks/last" + Helpers::networkPostfix(fNetVersion), number);
+        fStoredBlock = number;
+    }
+
+    void DbixIPC::onCatchUpBlock(const BlockInfo& block) {
+        postResult(IPCResult(block));
+    }
+
+    void DbixIPC::onCatchUpProgress(quint64 mergedBlock, quint64 toBlock __attribute__ ((unused))) {
+        if ( mergedBlock >= fStoredBlock + 100 ) { // so a restart resumes close to where we left off
+            storeLastBlock(mergedBlock);
+        }
+    }
+
+    void DbixIPC::onCatchUpFinished(quint64 toBlock __attribute__ ((unused))) {
+        storeLastBlock(fLiveBlock);
+    }
+
+    void DbixIPC::onCatchUpFailed(const QString& error) {
+        DbixLog::logMsg(error, LS_Warning);
+        fLiveBlock = fStoredBlock; // retry from the stored block on the next new one
+    }
+
+    void DbixIPC::onBulkFrame(const QByteArray& frame) {
+        DbixLog::logMsg("Received (bulk): " + QString::fromUtf8(frame), LS_Debug);
+        handleReply(frame); // handlers call done() themselves, same as on the main socket
+    }
+
+    void DbixIPC::onBulkWritten(const RequestIPC& request) {
+        fBulkRequests.insert(request.getCallID(), request);
+        if ( request.burden() == Full ) {
+            publishBusy();
+        }
+    }
+
+    // bulk connection went away, the main connection picks these up
+    void DbixIPC::onBulkLost(const RequestList& requests) {
+        foreach ( const RequestIPC& request, requests ) {
+            fBulkRequests.remove(request.getCallID());
+            fRequestQueue.enqueue(RequestList() << request);
+        }
+
+        if ( !flushQueue() ) {
+            return bail();
+        }
+    }
+
     void DbixIPC::getTransactionReceipt(const QString& hash) {
+        if ( offThread() ) {
+            QMetaObject::invokeMethod(this, "getTransactionReceipt", Qt::QueuedConnection, Q_ARG(QString, hash));
+            return;
+        }
+
         QJsonArray params;
         params.append(hash);
 
@@ -927,13 +1771,12 @@ namespace Dbixwall {
     }
 
     void DbixIPC::handleGetTransactionReceipt() {
-        QJsonValue jv;
-        if ( !readReply(jv) ) {
-            return bail();
+        QJsonObject receipt;
+        if ( !ReplyParser(fReply).parseReceipt(receipt) ) {
+            return bailDecode();
         }
 
-
-        emit getTransactionReceiptDone(jv.toObject());
+        postResult(IPCResult(receipt));
         done();
     }
 
@@ -948,15 +1791,15 @@ namespace Dbixwall {
         const int vn = parseVersionNum();
         if ( vn > 0 && vn < 104092 ) {
             setError("Gdbix version 1.4.92 and older are not ready for the upcoming 2nd hard fork. Please update Gdbix to ensure you are ready.");
-            emit error();
+            publishError();
         }
 
         if ( vn > 0 && vn < 105001 ) {
             setError("Gdbix version older than 1.5.1 is no longer supported. Please upgrade gdbix to 1.5.1+.");
-            emit error();
+            publishError();
         }
 
-        emit clientVersionChanged(fClientVersion);
+        publishState();
         done();
     }
 
@@ -974,7 +1817,7 @@ namespace Dbixwall {
             return bail(true);
         }
 
-        emit netVersionChanged(fNetVersion);
+        publishState();
         done();
 
         /*fTimer.start(); // should happen after filter creation, might need to move into last filter response handler
@@ -1000,7 +1843,7 @@ namespace Dbixwall {
                 if ( fBlockFilterID.isEmpty() ) {
                     newBlockFilter();
                 }
-                emit syncingChanged(fSyncing);
+                publishState();
             }
 
             return done();
@@ -1012,13 +1855,13 @@ namespace Dbixwall {
         fStartingBlock = Helpers::toQUInt64(syncing.value("startingBlock"));
         if ( !fSyncing ) {
             if ( !fBlockFilterID.isEmpty() ) {
-                uninstallFilter(fBlockFilterID);
+                uninstallFilter(fBlockFilterID, fBlockSubscribed);
                 fBlockFilterID.clear();
             }
             fSyncing = true;
         }
 
-        emit syncingChanged(fSyncing);
+        publishState();
         done();
     }
 
@@ -1028,8 +1871,14 @@ namespace Dbixwall {
         if ( !soft ) {
             fTimer.stop();
             fRequestQueue.clear();
+            fPendingRequests.clear(); // late replies to these get dropped in handleReply
+            fBulkRequests.clear();
+            fBulkPool.reset(); // the bulk connections stay up, nothing reopens them short of a reconnect
+            fFollowers.clear();
         }
 
+        fReplyFailed = true;
+
         fActiveRequest = RequestIPC(None);
         errorOut();
     }
@@ -1040,49 +1889,237 @@ namespace Dbixwall {
     }
 
     void DbixIPC::errorOut() {
-        emit error();
-        emit connectionStateChanged();
+        publishError();
+        publishState();
         done();
     }
 
     void DbixIPC::done() {
         fActiveRequest = RequestIPC(None);
-        if ( !fRequestQueue.isEmpty() ) {
-            const RequestIPC request = fRequestQueue.first();
-            fRequestQueue.removeFirst();
-            writeRequest(request);
-        } else {
-            emit busyChanged(getBusy());
+        if ( !flushQueue() ) {
+            return bail();
+        }
+
+        if ( !isBusy() ) {
+            publishBusy();
         }
     }
 
-    QJsonObject DbixIPC::methodToJSON(const RequestIPC& request) {
-        QJsonObject result;
+    // requests from the GUI thread get re-posted to the IPC thread
+    bool DbixIPC::offThread() const {
+        return QThread::currentThread() != thread();
+    }
 
-        result.insert("jsonrpc", QJsonValue(QString("2.0")));
-        result.insert("method", QJsonValue(request.getMethod()));
-        result.insert("id", QJsonValue(request.getCallID()));
-        result.insert("params", QJsonValue(request.getParams()));
+    void DbixIPC::publishBusy() {
+        const bool busy = isBusy();
+        fBusy.storeRelease(busy ? 1 : 0);
+        emit busyChanged(busy);
+    }
 
-        return result;
+    void DbixIPC::publishError() {
+        postResult(IPCResult(fError, fCode));
+    }
+
+    void DbixIPC::publishState() {
+        IPCState state;
+        state.fStarting = fStarting;
+        state.fExternal = fExternal;
+        state.fClosing = fClosingApp;
+        state.fConnected = fSocket.state() == QLocalSocket::ConnectedState;
+        state.fSyncing = fSyncing;
+        state.fPeerCount = fPeerCount;
+        state.fClientVersion = fClientVersion;
+        state.fNetVersion = fNetVersion;
+        state.fCurrentBlock = fCurrentBlock;
+        state.fHighestBlock = fHighestBlock;
+        state.fStartingBlock = fStartingBlock;
+        state.fBlockNumber = fBlockNumber;
+        postResult(IPCResult(state));
+    }
+
+    // GUI thread, notifies for whatever changed since the last published state
+    void DbixIPC::applyState(const IPCState& state) {
+        const IPCState old = fShownState;
+        fShownState = state;
+
+        if ( old.fStarting != state.fStarting ) {
+            emit startingChanged(getStarting());
+        }
+
+        if ( old.fExternal != state.fExternal ) {
+            emit externalChanged(state.fExternal);
+        }
+
+        if ( old.fClosing != state.fClosing ) {
+            emit closingChanged(state.fClosing);
+        }
+
+        if ( old.fConnected != state.fConnected ) {
+            emit connectionStateChanged();
+        }
+
+        if ( old.fClientVersion != state.fClientVersion ) {
+            emit clientVersionChanged(state.fClientVersion);
+        }
+
+        if ( old.fNetVersion != state.fNetVersion ) {
+            emit netVersionChanged(state.fNetVersion);
+        }
+
+        if ( old.fPeerCount != state.fPeerCount ) {
+            emit peerCountChanged(state.fPeerCount);
+        }
+
+        if ( old.fSyncing != state.fSyncing || old.fCurrentBlock != state.fCurrentBlock ||
+             old.fHighestBlock != state.fHighestBlock || old.fStartingBlock != state.fStartingBlock ) {
+            emit syncingChanged(state.fSyncing);
+        }
+
+        if ( old.fBlockNumber != state.fBlockNumber ) {
+            emit getBlockNumberDone(state.fBlockNumber);
+        }
+    }
+
+    void DbixIPC::postResult(const IPCResult& result) {
+        if ( fResults.push(result) ) {
+            QMetaObject::invokeMethod(&fDispatcher, "drain", Qt::QueuedConnection);
+        }
+    }
+
+    // GUI thread, hands everything queued so far to the models in one go
+    void DbixIPC::drainResults() {
+        IPCResult result;
+        int count;
+
+        do {
+            count = fResults.count();
+            for ( int i = 0; i < count; i++ ) {
+                fResults.pop(result);
+
+                switch ( result.fType ) {
+                case AccountsResult: emit getAccountsDone(result.fAccounts); break;
+                case AccountResult: emit accountChanged(result.fAccounts.first()); break;
+                case TransactionResult: emit newTransaction(result.fTransaction); break;
+                case BlockResult: emit newBlock(result.fBlock); break;
+                case EventResult: emit newEvent(result.fEvent, result.fNew); break;
+                case ErrorResult: {
+                        fShownError = result.fError;
+                        fShownCode = result.fCode;
+                        emit error();
+                        break;
+                    }
+                case StateResult: applyState(result.fState); break;
+                case ConnectedResult: emit connectToServerDone(); break;
+                case NewAccountResult: emit newAccountDone(result.fError, result.fCode); break;
+                case DeleteAccountResult: emit deleteAccountDone(result.fNew, result.fCode); break;
+                case SendTransactionResult: emit sendTransactionDone(result.fError); break;
+                case UnlockAccountResult: emit unlockAccountDone(result.fNew, result.fCode); break;
+                case GasPriceResult: emit getGasPriceDone(result.fError); break;
+                case EstimateGasResult: emit estimateGasDone(result.fError); break;
+                case ReceiptResult: emit getTransactionReceiptDone(result.fReceipt); break;
+                default: break;
+                }
+            }
+        } while ( !fResults.release(count) );
+    }
+
+    QJsonObject DbixIPC::methodToJSON(const RequestIPC& request) {
+        return request.toJson();
     }
 
     bool DbixIPC::queueRequest(const RequestIPC& request) {
-        if ( fActiveRequest.burden() == None ) {
-            return writeRequest(request);
-        } else {
-            fRequestQueue.append(request);
+        if ( coalesce(request) ) {
+            return true;
+        }
+
+        if ( request.bulk() && fBulkPool.isReady() ) {
+            fBulkPool.enqueue(request);
+            return true;
+        }
+
+        fRequestQueue.enqueue(RequestList() << request);
+        return flushQueue();
+    }
+
+    bool DbixIPC::queueBatch(const RequestList& batch) {
+        RequestList requests;
+        foreach ( const RequestIPC& request, batch ) {
+            if ( !coalesce(request) ) {
+                requests.append(request);
+            }
+        }
+
+        if ( requests.isEmpty() ) {
+            return true;
+        }
+
+        fRequestQueue.enqueue(requests);
+        return flushQueue();
+    }
+
+    // merges the request into an identical queued or in flight call, returns true if merged
+    bool DbixIPC::coalesce(const RequestIPC& request) {
+        if ( !request.idempotent() ) {
+            return false;
+        }
+
+        RequestIPC primary;
+        if ( !fRequestQueue.find(request, primary) ) {
+            foreach ( const RequestIPC& pending, fPendingRequests.values() + fBulkRequests.values() ) {
+                if ( pending.sameResult(request) ) {
+                    primary = pending;
+                    break;
+                }
+            }
+        }
+
+        if ( primary.getCallID() < 0 ) {
+            return false;
+        }
+
+        // the same caller asking twice only needs the one answer
+        if ( primary.sameCall(request) ) {
             return true;
         }
+
+        RequestList& followers = fFollowers[primary.getCallID()];
+        foreach ( const RequestIPC& follower, followers ) {
+            if ( follower.sameCall(request) ) {
+                return true;
+            }
+        }
+
+        followers.append(request);
+        return true;
     }
 
-    bool DbixIPC::writeRequest(const RequestIPC& request) {
-        fActiveRequest = request;
-        if ( fActiveRequest.burden() == Full ) {
-            emit busyChanged(getBusy());
+    bool DbixIPC::flushQueue() {
+        if ( fSocket.state() == QLocalSocket::ConnectingState ) {
+            return true; // connectedToServer will flush once we're in
+        }
+
+        // keep up to fPipelineDepth requests in flight, replies are matched back by call ID
+        // a batch is admitted as a whole as long as there's room for at least one more request
+        while ( !fRequestQueue.isEmpty() && fPendingRequests.size() < fPipelineDepth ) {
+            if ( !writeRequest(fRequestQueue.dequeue()) ) {
+                return false;
+            }
         }
 
-        QJsonDocument doc(methodToJSON(fActiveRequest));
+        return true;
+    }
+
+    bool DbixIPC::writeRequest(const RequestList& requests) {
+        QJsonDocument doc;
+        if ( requests.size() == 1 ) {
+            doc.setObject(methodToJSON(requests.first()));
+        } else {
+            QJsonArray batch;
+            foreach ( const RequestIPC& request, requests ) {
+                batch.append(methodToJSON(request));
+            }
+            doc.setArray(batch);
+        }
         const QString msg(doc.toJson());
 
         if ( !fSocket.isWritable() ) {
@@ -1101,45 +2138,34 @@ namespace Dbixwall {
             return false;
         }
 
-        return true;
-    }
-
-    bool DbixIPC::readData() {
-        fReadBuffer += QString(fSocket.readAll()).trimmed();
+        bool full = false;
+        foreach ( const RequestIPC& request, requests ) {
+            fPendingRequests.insert(request.getCallID(), request);
+            full = full || request.burden() == Full;
+        }
 
-        if ( fReadBuffer.at(0) == '{' && fReadBuffer.at(fReadBuffer.length() - 1) == '}' && fReadBuffer.count('{') == fReadBuffer.count('}') ) {
-            DbixLog::logMsg("Received: " + fReadBuffer, LS_Debug);
-            return true;
+        if ( full ) {
+            publishBusy();
         }
 
-        return false;
+        return true;
     }
 
     bool DbixIPC::readReply(QJsonValue& result) {
-        const QString data = fReadBuffer;
-        fReadBuffer.clear();
-
-        if ( data.isEmpty() ) {
-            setError("Error on socket read: " + fSocket.errorString());
-            fCode = 0;
-            return false;
-        }
-
         QJsonParseError parseError;
-        QJsonDocument resDoc = QJsonDocument::fromJson(data.toUtf8(), &parseError);
+        const QJsonDocument resDoc = QJsonDocument::fromJson(fReply, &parseError);
 
         if ( parseError.error != QJsonParseError::NoError ) {
-            qDebug() << data << "\n";
+            qDebug() << fReply << "\n";
             setError("Response parse error: " + parseError.errorString());
             fCode = 0;
             return false;
         }
 
         const QJsonObject obj = resDoc.object();
-        const int objID = obj["id"].toInt(-1);
 
-        if ( objID != fActiveRequest.getCallID() ) { // TODO
-            setError("Call number mismatch " + QString::number(objID) + " != " + QString::number(fActiveRequest.getCallID()));
+        if ( obj.isEmpty() ) {
+            setError("Error on socket read: " + fSocket.errorString());
             fCode = 0;
             return false;
         }
@@ -1166,7 +2192,7 @@ namespace Dbixwall {
 
             if ( fActiveRequest.getType() != GetTransactionByHash ) { // this can happen if out of sync, it's not fatal for transaction get
                 setError("Result object undefined in IPC response for request: " + fActiveRequest.getMethod());
-                qDebug() << data << "\n";
+                qDebug() << QJsonDocument(obj).toJson() << "\n";
                 return false;
             }
         }
@@ -1174,25 +2200,41 @@ namespace Dbixwall {
         return true;
     }
 
-    bool DbixIPC::readVin(BigInt::Vin& result) {
+    // the typed decoders only handle results, errors and missing results are read the usual way
+    void DbixIPC::bailDecode() {
+        QJsonValue jv;
+        if ( readReply(jv) ) {
+            setError("Unable to decode IPC response for request: " + fActiveRequest.getMethod());
+            fCode = 0;
+        }
+
+        bail();
+    }
+
+    bool DbixIPC::readUInt256(UInt256& result) {
         QJsonValue jv;
         if ( !readReply(jv) ) {
             return false;
         }
 
-        std::string hexStr = jv.toString("0x0").remove(0, 2).toStdString();
-        result = BigInt::Vin(hexStr, 16);
+        bool ok = false;
+        result = UInt256::fromHex(jv.toString("0x0"), &ok);
+        if ( !ok ) {
+            setError("Invalid quantity in reply: " + jv.toString());
+            fCode = 0;
+            return false;
+        }
 
         return true;
     }
 
     bool DbixIPC::readNumber(quint64& result) {
-        BigInt::Vin r;
-        if ( !readVin(r) ) {
+        UInt256 r;
+        if ( !readUInt256(r) ) {
             return false;
         }
 
-        result = r.toUlong();
+        result = r.toUInt64();
         return true;
     }
 
@@ -1202,14 +2244,80 @@ namespace Dbixwall {
     }
 
     void DbixIPC::onSocketReadyRead() {
-        if ( !getBusy() ) {
-            return; // probably error-ed out
+        fFrameReader.append(fSocket.readAll());
+
+        // with pipelining one read can hold several replies, batch replies come as a top level array
+        QByteArray frame;
+        while ( fFrameReader.next(frame) ) {
+            DbixLog::logMsg("Received: " + QString::fromUtf8(frame), LS_Debug);
+            handleReply(frame);
+        }
+    }
+
+    void DbixIPC::handleReply(const QByteArray& frame) {
+        if ( ReplyParser::isBatch(frame) ) { // batch reply, fan out to individual handlers
+            QList<QByteArray> replies;
+            if ( !ReplyParser::splitBatch(frame, replies) ) {
+                qDebug() << frame << "\n";
+                setError("Response parse error: malformed batch reply");
+                fCode = 0;
+                return bail();
+            }
+
+            foreach ( const QByteArray& reply, replies ) {
+                processReply(reply);
+            }
+            return;
+        }
+
+        processReply(frame);
+    }
+
+    void DbixIPC::processReply(const QByteArray& reply) {
+        // only the id is peeked here, handlers decode the rest straight from the raw reply
+        fReply = reply;
+        const int objID = ReplyParser::callID(fReply);
+
+        if ( !fPendingRequests.contains(objID) && !fBulkRequests.contains(objID) ) {
+            const QString subscription = objID < 0 ? ReplyParser::subscriptionID(fReply) : QString();
+            if ( !subscription.isEmpty() ) {
+                return handleNotification(subscription);
+            }
+
+            const QJsonObject obj = objID < 0 ? QJsonDocument::fromJson(fReply).object() : QJsonObject();
+            if ( obj.contains("error") ) { // whole batch got rejected
+                setError(obj.value("error").toObject().value("message").toString("Invalid batch request"));
+                fCode = obj.value("error").toObject().value("code").toInt();
+                return bail();
+            }
+
+            // probably error-ed out and got dropped
+            DbixLog::logMsg("Dropping reply for unknown call number " + QString::number(objID), LS_Warning);
+            return;
+        }
+
+        // coalesced callers get the very same reply, unless it made us bail
+        const RequestList followers = fFollowers.take(objID);
+        if ( fBulkRequests.contains(objID) ) {
+            fActiveRequest = fBulkRequests.take(objID);
+            fBulkPool.finished(objID);
+        } else {
+            fActiveRequest = fPendingRequests.take(objID);
         }
+        fReplyFailed = false;
+        dispatchReply();
+
+        foreach ( const RequestIPC& follower, followers ) {
+            if ( fReplyFailed ) {
+                break;
+            }
 
-        if ( !readData() ) {
-            return; // not finished yet
+            fActiveRequest = follower;
+            dispatchReply();
         }
+    }
 
+    void DbixIPC::dispatchReply() {
         switch ( fActiveRequest.getType() ) {
         case NewAccount: {
                 handleNewAccount();
@@ -1299,7 +2407,12 @@ namespace Dbixwall {
                 handleGetTransactionReceipt();
                 break;
             }
-        default: qDebug() << "Unknown reply: " << fActiveRequest.getType() << "\n"; break;
+        case SubscribeNewHeads:
+        case SubscribeLogs: {
+                handleSubscribe();
+                break;
+            }
+        default: qDebug() << "Unknown reply: " << fActiveRequest.getType() << "\n"; done(); break;
         }
     }
 
@@ -23,6 +23,7 @@
 
 #include <QObject>
 #include <QList>
+#include <QMap>
 #include <QLocalSocket>
 #include <QJsonObject>
 #include <QJsonArray>
@@ -32,10 +33,16 @@
 #include <QThread>
 #include <QProcess>
 #include <QTime>
+#include <QElapsedTimer>
+#include <QAtomicInt>
+#include <QAtomicPointer>
 #include "types.h"
+#include "contractinfo.h"
+#include "ipcconnection.h"
+#include "blockcatchup.h"
 #include "dbixlog.h"
 #include "gdbixlog.h"
-#include "bigint.h"
+#include "uint256.h"
 
 namespace Dbixwall {
 
@@ -45,11 +52,18 @@ namespace Dbixwall {
         None
     };
 
+    enum RequestPriority {
+        Interactive, // user initiated, always goes out first
+        Regular,
+        Background, // timer polls
+        PriorityCount
+    };
+
     class RequestIPC {
     public:
         RequestIPC(RequestBurden burden, RequestTypes type, const QString method, const QJsonArray params = QJsonArray(), int index = -1);
         RequestIPC(RequestTypes type, const QString method, const QJsonArray params = QJsonArray(), int index = -1);
-        RequestIPC(RequestBurden burden);
+        RequestIPC(RequestBurden burden = None);
 
         RequestTypes getType() const;
         const QString& getMethod() const;
@@ -57,6 +71,12 @@ namespace Dbixwall {
         int getIndex() const;
         int getCallID() const;
         RequestBurden burden() const;
+        RequestPriority priority() const;
+        bool sameCall(const RequestIPC& other) const;
+        bool sameResult(const RequestIPC& other) const;
+        bool idempotent() const;
+        bool bulk() const;
+        const QJsonObject toJson() const;
         static int sCallID;
     private:
         int fCallID;
@@ -68,6 +88,168 @@ namespace Dbixwall {
     };
 
     typedef QList<RequestIPC> RequestList;
+    typedef QList<RequestList> RequestQueue; // each entry is written as one frame, a JSON-RPC batch if it holds more requests
+    typedef QMap<int, RequestIPC> RequestMap; // call ID -> request written to the socket and awaiting reply
+
+    // one queue per priority class, the highest non-empty class is always served first
+    class RequestScheduler {
+    public:
+        RequestScheduler();
+
+        bool enqueue(const RequestList& requests);
+        const RequestList dequeue();
+        bool find(const RequestIPC& request, RequestIPC& found) const;
+        bool isEmpty() const;
+        void clear();
+        int depth(RequestPriority priority) const;
+        qint64 averageWait(RequestPriority priority) const;
+        qint64 maxWait(RequestPriority priority) const;
+        const QString stats() const;
+    private:
+        RequestQueue fQueues[PriorityCount];
+        QList<qint64> fQueuedAt[PriorityCount];
+        qint64 fTotalWait[PriorityCount];
+        qint64 fMaxWait[PriorityCount];
+        int fServed[PriorityCount];
+        QElapsedTimer fClock;
+
+        static RequestPriority priorityOf(const RequestList& requests);
+    };
+
+    enum IPCResultType {
+        NoResult,
+        AccountsResult,
+        AccountResult,
+        TransactionResult,
+        BlockResult,
+        EventResult,
+        ErrorResult,
+        StateResult,
+        ConnectedResult,
+        NewAccountResult,
+        DeleteAccountResult,
+        SendTransactionResult,
+        UnlockAccountResult,
+        GasPriceResult,
+        EstimateGasResult,
+        ReceiptResult
+    };
+
+    // properties shown to QML and the models, published as a whole by the IPC thread
+    class IPCState {
+    public:
+        IPCState();
+
+        int fStarting;
+        bool fExternal;
+        bool fClosing;
+        bool fConnected;
+        bool fSyncing;
+        quint64 fPeerCount;
+        QString fClientVersion;
+        int fNetVersion;
+        quint64 fCurrentBlock;
+        quint64 fHighestBlock;
+        quint64 fStartingBlock;
+        quint64 fBlockNumber;
+    };
+
+    // decoded result handed over from the IPC thread to the GUI thread
+    class IPCResult {
+    public:
+        IPCResult();
+        IPCResult(IPCResultType type, const AccountList& accounts);
+        IPCResult(const TransactionInfo& transaction);
+        IPCResult(const BlockInfo& block);
+        IPCResult(const EventInfo& event, bool isNew);
+        IPCResult(const QString& error, int code);
+        IPCResult(const IPCState& state);
+        IPCResult(IPCResultType type);
+        IPCResult(IPCResultType type, const QString& text, int index);
+        IPCResult(IPCResultType type, bool flag, int index);
+        IPCResult(const QJsonObject& receipt);
+    private:
+        IPCResultType fType;
+        AccountList fAccounts;
+        TransactionInfo fTransaction;
+        BlockInfo fBlock;
+        EventInfo fEvent;
+        bool fNew; // event is new, or the outcome of a delete or unlock
+        QString fError; // error message, or the text result of the request
+        int fCode; // error code, or the account index of the request
+        IPCState fState;
+        QJsonObject fReceipt;
+
+        friend class DbixIPC;
+    };
+
+    // lock-free single producer (IPC thread) single consumer (GUI thread) queue
+    class ResultQueue {
+    public:
+        ResultQueue();
+        ~ResultQueue();
+
+        bool push(const IPCResult& result);
+        int count() const;
+        bool pop(IPCResult& result);
+        bool release(int count);
+    private:
+        class Node {
+        public:
+            Node(const IPCResult& result);
+            IPCResult fResult;
+            QAtomicPointer<Node> fNext;
+        };
+
+        Node* fHead; // consumer side, always a consumed (dummy) node
+        Node* fTail; // producer side
+        QAtomicInt fCount; // pushed but not yet released by the consumer
+    };
+
+    // extra IPC connections for bulk and historical calls, each with its own queue,
+    // so long running calls never hold up the main connection
+    class ConnectionPool: public QObject
+    {
+        Q_OBJECT
+    public:
+        ConnectionPool(QObject* parent = 0);
+
+        void open(const QString& path, int size, int depth);
+        void close();
+        void reset();
+        bool isReady() const;
+        void enqueue(const RequestIPC& request);
+        void finished(int callID);
+    signals:
+        void frameReceived(const QByteArray& frame) const;
+        void written(const RequestIPC& request) const;
+        void lost(const RequestList& requests) const;
+    private slots:
+        void onOpened();
+        void onFailed(const QString& error);
+    private:
+        QList<IPCConnection*> fConnections;
+        QMap<IPCConnection*, RequestList> fQueues;
+        QMap<IPCConnection*, RequestList> fInFlight;
+        QMap<int, IPCConnection*> fCalls; // call ID -> connection it was written to
+        int fDepth;
+
+        void flush(IPCConnection* connection);
+    };
+
+    class DbixIPC;
+
+    // lives on the GUI thread and drains the result queue there, once per wake up
+    class ResultDispatcher: public QObject
+    {
+        Q_OBJECT
+    public:
+        ResultDispatcher(DbixIPC& ipc);
+    public slots:
+        void drain();
+    private:
+        DbixIPC& fIpc;
+    };
 
     class DbixIPC: public QObject
     {
@@ -82,13 +264,13 @@ namespace Dbixwall {
         //Q_PROPERTY(bool hardForkReady READ getHardForkReady NOTIFY hardForkReadyChanged)
         Q_PROPERTY(int connectionState READ getConnectionState NOTIFY connectionStateChanged)
         Q_PROPERTY(quint64 peerCount READ peerCount NOTIFY peerCountChanged)
-        Q_PROPERTY(QString clientVersion MEMBER fClientVersion NOTIFY clientVersionChanged)
-        Q_PROPERTY(int netVersion MEMBER fNetVersion NOTIFY netVersionChanged)
+        Q_PROPERTY(QString clientVersion READ getClientVersion NOTIFY clientVersionChanged)
+        Q_PROPERTY(int netVersion READ network NOTIFY netVersionChanged)
         Q_PROPERTY(bool testnet READ getTestnet NOTIFY netVersionChanged)
         Q_PROPERTY(quint64 currentBlock READ getCurrentBlock NOTIFY syncingChanged)
         Q_PROPERTY(quint64 highestBlock READ getHighestBlock NOTIFY syncingChanged)
         Q_PROPERTY(quint64 startingBlock READ getStartingBlock NOTIFY syncingChanged)
-        Q_PROPERTY(quint64 blockNumber MEMBER fBlockNumber NOTIFY getBlockNumberDone)
+        Q_PROPERTY(quint64 blockNumber READ blockNumber NOTIFY getBlockNumberDone)
     public:
         DbixIPC(const QString& ipcPath, GdbixLog& gdbixLog);
         virtual ~DbixIPC();
@@ -101,6 +283,7 @@ namespace Dbixwall {
         const QString& getError() const;
         int getCode() const;
         bool getTestnet() const;
+        const QString& getClientVersion() const;
         const QString getNetworkPostfix() const;
         quint64 blockNumber() const;
 		int network() const;
@@ -113,6 +296,7 @@ namespace Dbixwall {
         void disconnectedFromServer();
         void getAccounts();
         bool refreshAccount(const QString& hash, int index);
+        bool refreshAccounts(const QStringList& hashes);
         bool getBalance(const QString& hash, int index);
         bool getTransactionCount(const QString& hash, int index);
         void newAccount(const QString& password, int index);
@@ -133,6 +317,7 @@ namespace Dbixwall {
         void onSocketError(QLocalSocket::LocalSocketError err);
         Q_INVOKABLE void setInterval(int interval);
         bool closeApp();
+        void shutdown();
         void registerEventFilters(const QStringList& addresses, const QStringList& topics);
         void loadLogs(const QStringList& addresses, const QStringList& topics, quint64 fromBlock);
     signals:
@@ -146,8 +331,8 @@ namespace Dbixwall {
         void getGasPriceDone(const QString& price) const;
         void estimateGasDone(const QString& price) const;
         void newTransaction(const TransactionInfo& info) const;
-        void newBlock(const QJsonObject& block) const;
-        void newEvent(const QJsonObject& event, bool isNew) const;
+        void newBlock(const BlockInfo& block) const;
+        void newEvent(const EventInfo& event, bool isNew) const;
         void getTransactionReceiptDone(const QJsonObject& receipt) const;
 
         void peerCountChanged(quint64 num) const;
@@ -164,17 +349,28 @@ namespace Dbixwall {
         void error() const;
     private:
         QString fPath;
+        ResultQueue fResults;
+        ResultDispatcher fDispatcher;
+        QAtomicInt fBusy; // busy state as last published to the GUI thread
+        QString fShownError; // error and code as last published to the GUI thread
+        int fShownCode;
+        IPCState fShownState; // properties as last published to the GUI thread
         QLocalSocket fSocket;
         QString fBlockFilterID;
         bool fClosingApp;
         quint64 fPeerCount;
-        QString fReadBuffer;
+        FrameReader fFrameReader;
+        QByteArray fReply;
         QString fError;
         int fCode;
         AccountList fAccountList;
         TransactionList fTransactionList;
-        RequestList fRequestQueue;
+        RequestScheduler fRequestQueue;
+        RequestMap fPendingRequests;
+        QMap<int, RequestList> fFollowers; // call ID -> coalesced requests answered by its reply
+        bool fReplyFailed;
         RequestIPC fActiveRequest;
+        int fPipelineDepth;
         QTimer fTimer;
         int fNetVersion;
         QString fClientVersion;
@@ -189,7 +385,16 @@ namespace Dbixwall {
         QTime fKillTime;
         bool fExternal;
         QString fEventFilterID;
+        bool fBlockSubscribed; // filter IDs hold eth_subscribe subscription IDs
+        bool fEventSubscribed;
+        bool fSubscribe;
+        QJsonObject fEventFilterParams;
         quint64 fBlockNumber;
+        BlockCatchUp fCatchUp;
+        quint64 fLiveBlock; // last block seen this session
+        quint64 fStoredBlock; // last block persisted as processed
+        ConnectionPool fBulkPool;
+        RequestMap fBulkRequests; // written to the bulk pool, kept apart so they don't count against fPipelineDepth
 
         void handleNewAccount();
         void handleDeleteAccount();
@@ -212,6 +417,18 @@ namespace Dbixwall {
         void handleGetClientVersion();
         void handleGetNetVersion();
         void handleGetSyncing();
+        void handleSubscribe();
+        void trackBlock(quint64 number);
+        quint64 storedLastBlock() const;
+        void storeLastBlock(quint64 number);
+        void onCatchUpBlock(const BlockInfo& block);
+        void onCatchUpProgress(quint64 mergedBlock, quint64 toBlock);
+        void onCatchUpFinished(quint64 toBlock);
+        void onCatchUpFailed(const QString& error);
+        void onBulkFrame(const QByteArray& frame);
+        void onBulkWritten(const RequestIPC& request);
+        void onBulkLost(const RequestList& requests);
+        void handleNotification(const QString& subscription);
 
 		void ipcReady();
         void onTimer();
@@ -227,23 +444,39 @@ namespace Dbixwall {
         quint64 getStartingBlock() const;
         int getConnectionState() const;
         quint64 peerCount() const;
+        bool isBusy() const;
+        bool offThread() const;
+        void publishBusy();
+        void publishError();
+        void publishState();
+        void applyState(const IPCState& state);
+        void postResult(const IPCResult& result);
+        void drainResults();
         void bail(bool soft = false);
         void setError(const QString& error);
         void errorOut();
         void done();
         void newBlockFilter();
         void newEventFilter(const QStringList& addresses, const QStringList& topics);
-        void uninstallFilter(const QString& filter);
+        void uninstallFilter(const QString& filter, bool subscription = false);
         void getLogs(const QStringList& addresses, const QStringList& topics, quint64 fromBlock);
 
         QJsonObject methodToJSON(const RequestIPC& request);
         bool queueRequest(const RequestIPC& request);
-        bool writeRequest(const RequestIPC& request);
-        bool readData();
+        bool queueBatch(const RequestList& batch);
+        bool coalesce(const RequestIPC& request);
+        bool flushQueue();
+        bool writeRequest(const RequestList& requests);
+        void handleReply(const QByteArray& frame);
+        void processReply(const QByteArray& reply);
+        void dispatchReply();
         bool readReply(QJsonValue& result);
-        bool readVin(BigInt::Vin& result);
+        void bailDecode();
+        bool readUInt256(UInt256& result);
         bool readNumber(quint64& result);
         const QString toDecStr(const QJsonValue& jv) const;
+
+        friend class ResultDispatcher;
     };
 
 }
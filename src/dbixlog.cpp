@@ -3,6 +3,7 @@
 #include <QSettings>
 #include <QApplication>
 #include <QClipboard>
+#include <QThread>
 
 namespace Dbixwall {
 
@@ -56,8 +57,17 @@ namespace Dbixwall {
             msg = "account content *REDACTED*";
         }
 
+        if ( QThread::currentThread() != thread() ) { // logging from the IPC thread
+            QMetaObject::invokeMethod(this, "insertLog", Qt::QueuedConnection, Q_ARG(QString, msg), Q_ARG(int, sev));
+            return;
+        }
+
+        insertLog(msg, sev);
+    }
+
+    void DbixLog::insertLog(const QString& msg, int sev) {
         beginInsertRows(QModelIndex(), 0, 0);
-        fList.insert(0, LogInfo(msg, sev));
+        fList.insert(0, LogInfo(msg, (LogSeverity)sev));
         endInsertRows();
     }
 
@@ -24,7 +24,8 @@ namespace Dbixwall {
         void setLogLevel(int ll);
     signals:
         void logLevelChanged();
-    public slots:
+    private slots:
+        void insertLog(const QString& msg, int sev);
     private:
         LogList fList;
         LogSeverity fLogLevel;
@@ -0,0 +1,417 @@
+#include "keccak.h"
+#include <QtEndian>
+#include <cstring>
+
+#if defined(__GNUC__) && defined(__SSE2__) && ( defined(__x86_64__) || defined(__i386__) )
+#define KECCAK_X86
+#include <immintrin.h>
+#endif
+
+namespace Dubaicoin {
+
+    static const quint64 sRoundConstants[24] = {
+        Q_UINT64_C(0x0000000000000001), Q_UINT64_C(0x0000000000008082), Q_UINT64_C(0x800000000000808a),
+        Q_UINT64_C(0x8000000080008000), Q_UINT64_C(0x000000000000808b), Q_UINT64_C(0x0000000080000001),
+        Q_UINT64_C(0x8000000080008081), Q_UINT64_C(0x8000000000008009), Q_UINT64_C(0x000000000000008a),
+        Q_UINT64_C(0x0000000000000088), Q_UINT64_C(0x0000000080008009), Q_UINT64_C(0x000000008000000a),
+        Q_UINT64_C(0x000000008000808b), Q_UINT64_C(0x800000000000008b), Q_UINT64_C(0x8000000000008089),
+        Q_UINT64_C(0x8000000000008003), Q_UINT64_C(0x8000000000008002), Q_UINT64_C(0x8000000000000080),
+        Q_UINT64_C(0x000000000000800a), Q_UINT64_C(0x800000008000000a), Q_UINT64_C(0x8000000080008081),
+        Q_UINT64_C(0x8000000000008080), Q_UINT64_C(0x0000000080000001), Q_UINT64_C(0x8000000080008008)
+    };
+
+#define ROL64(a, n) ( ( (a) << (n) ) | ( (a) >> (64 - (n)) ) )
+
+    // Keccak-f[1600], all 25 lanes kept in locals with theta, rho, pi and chi written out.
+    // Lane (x, y) is a[x + 5 * y], b holds the lanes after rho and pi.
+    static void keccakF1600(quint64* s)
+    {
+        quint64 a00 = s[0], a01 = s[1], a02 = s[2], a03 = s[3], a04 = s[4];
+        quint64 a05 = s[5], a06 = s[6], a07 = s[7], a08 = s[8], a09 = s[9];
+        quint64 a10 = s[10], a11 = s[11], a12 = s[12], a13 = s[13], a14 = s[14];
+        quint64 a15 = s[15], a16 = s[16], a17 = s[17], a18 = s[18], a19 = s[19];
+        quint64 a20 = s[20], a21 = s[21], a22 = s[22], a23 = s[23], a24 = s[24];
+        quint64 b00, b01, b02, b03, b04, b05, b06, b07, b08, b09, b10, b11, b12;
+        quint64 b13, b14, b15, b16, b17, b18, b19, b20, b21, b22, b23, b24;
+        quint64 c0, c1, c2, c3, c4, d0, d1, d2, d3, d4;
+
+        for ( int round = 0; round < 24; round++ ) {
+            c0 = a00 ^ a05 ^ a10 ^ a15 ^ a20;
+            c1 = a01 ^ a06 ^ a11 ^ a16 ^ a21;
+            c2 = a02 ^ a07 ^ a12 ^ a17 ^ a22;
+            c3 = a03 ^ a08 ^ a13 ^ a18 ^ a23;
+            c4 = a04 ^ a09 ^ a14 ^ a19 ^ a24;
+            d0 = c4 ^ ROL64(c1, 1);
+            d1 = c0 ^ ROL64(c2, 1);
+            d2 = c1 ^ ROL64(c3, 1);
+            d3 = c2 ^ ROL64(c4, 1);
+            d4 = c3 ^ ROL64(c0, 1);
+
+            b00 = a00 ^ d0;
+            b01 = ROL64(a06 ^ d1, 44);
+            b02 = ROL64(a12 ^ d2, 43);
+            b03 = ROL64(a18 ^ d3, 21);
+            b04 = ROL64(a24 ^ d4, 14);
+            b05 = ROL64(a03 ^ d3, 28);
+            b06 = ROL64(a09 ^ d4, 20);
+            b07 = ROL64(a10 ^ d0, 3);
+            b08 = ROL64(a16 ^ d1, 45);
+            b09 = ROL64(a22 ^ d2, 61);
+            b10 = ROL64(a01 ^ d1, 1);
+            b11 = ROL64(a07 ^ d2, 6);
+            b12 = ROL64(a13 ^ d3, 25);
+            b13 = ROL64(a19 ^ d4, 8);
+            b14 = ROL64(a20 ^ d0, 18);
+            b15 = ROL64(a04 ^ d4, 27);
+            b16 = ROL64(a05 ^ d0, 36);
+            b17 = ROL64(a11 ^ d1, 10);
+            b18 = ROL64(a17 ^ d2, 15);
+            b19 = ROL64(a23 ^ d3, 56);
+            b20 = ROL64(a02 ^ d2, 62);
+            b21 = ROL64(a08 ^ d3, 55);
+            b22 = ROL64(a14 ^ d4, 39);
+            b23 = ROL64(a15 ^ d0, 41);
+            b24 = ROL64(a21 ^ d1, 2);
+
+            a00 = b00 ^ (~b01 & b02);
+            a01 = b01 ^ (~b02 & b03);
+            a02 = b02 ^ (~b03 & b04);
+            a03 = b03 ^ (~b04 & b00);
+            a04 = b04 ^ (~b00 & b01);
+            a05 = b05 ^ (~b06 & b07);
+            a06 = b06 ^ (~b07 & b08);
+            a07 = b07 ^ (~b08 & b09);
+            a08 = b08 ^ (~b09 & b05);
+            a09 = b09 ^ (~b05 & b06);
+            a10 = b10 ^ (~b11 & b12);
+            a11 = b11 ^ (~b12 & b13);
+            a12 = b12 ^ (~b13 & b14);
+            a13 = b13 ^ (~b14 & b10);
+            a14 = b14 ^ (~b10 & b11);
+            a15 = b15 ^ (~b16 & b17);
+            a16 = b16 ^ (~b17 & b18);
+            a17 = b17 ^ (~b18 & b19);
+            a18 = b18 ^ (~b19 & b15);
+            a19 = b19 ^ (~b15 & b16);
+            a20 = b20 ^ (~b21 & b22);
+            a21 = b21 ^ (~b22 & b23);
+            a22 = b22 ^ (~b23 & b24);
+            a23 = b23 ^ (~b24 & b20);
+            a24 = b24 ^ (~b20 & b21);
+
+            a00 ^= sRoundConstants[round];
+        }
+
+        s[0] = a00; s[1] = a01; s[2] = a02; s[3] = a03; s[4] = a04;
+        s[5] = a05; s[6] = a06; s[7] = a07; s[8] = a08; s[9] = a09;
+        s[10] = a10; s[11] = a11; s[12] = a12; s[13] = a13; s[14] = a14;
+        s[15] = a15; s[16] = a16; s[17] = a17; s[18] = a18; s[19] = a19;
+        s[20] = a20; s[21] = a21; s[22] = a22; s[23] = a23; s[24] = a24;
+    }
+
+    static void absorbBlock(quint64* state, const uchar* block)
+    {
+        for ( int i = 0; i < Keccak256::RATE / 8; i++ ) {
+            state[i] ^= qFromLittleEndian<quint64>(block + 8 * i);
+        }
+        keccakF1600(state);
+    }
+
+    // last block of a message: the tail plus the 0x01 ... 0x80 Keccak padding
+    static void padBlock(const uchar* tail, int size, uchar* block)
+    {
+        memset(block, 0, Keccak256::RATE);
+        memcpy(block, tail, size);
+        block[size] ^= 0x01;
+        block[Keccak256::RATE - 1] ^= 0x80;
+    }
+
+    static void squeeze(const quint64* state, uchar* out)
+    {
+        for ( int i = 0; i < Keccak256::HASH_SIZE / 8; i++ ) {
+            qToLittleEndian<quint64>(state[i], out + 8 * i);
+        }
+    }
+
+#ifdef KECCAK_X86
+#define XOR256(a, b) _mm256_xor_si256(a, b)
+#define XOR5(a, b, c, d, e) XOR256(XOR256(XOR256(a, b), XOR256(c, d)), e)
+#define ROL256(a, n) _mm256_or_si256(_mm256_slli_epi64(a, n), _mm256_srli_epi64(a, 64 - (n)))
+
+    // the same permutation over four independent states, lane i of state k in element k
+    __attribute__((target("avx2")))
+    static void keccakF1600x4(__m256i* s)
+    {
+        __m256i a00 = s[0], a01 = s[1], a02 = s[2], a03 = s[3], a04 = s[4];
+        __m256i a05 = s[5], a06 = s[6], a07 = s[7], a08 = s[8], a09 = s[9];
+        __m256i a10 = s[10], a11 = s[11], a12 = s[12], a13 = s[13], a14 = s[14];
+        __m256i a15 = s[15], a16 = s[16], a17 = s[17], a18 = s[18], a19 = s[19];
+        __m256i a20 = s[20], a21 = s[21], a22 = s[22], a23 = s[23], a24 = s[24];
+        __m256i b00, b01, b02, b03, b04, b05, b06, b07, b08, b09, b10, b11, b12;
+        __m256i b13, b14, b15, b16, b17, b18, b19, b20, b21, b22, b23, b24;
+        __m256i c0, c1, c2, c3, c4, d0, d1, d2, d3, d4;
+
+        for ( int round = 0; round < 24; round++ ) {
+            c0 = XOR5(a00, a05, a10, a15, a20);
+            c1 = XOR5(a01, a06, a11, a16, a21);
+            c2 = XOR5(a02, a07, a12, a17, a22);
+            c3 = XOR5(a03, a08, a13, a18, a23);
+            c4 = XOR5(a04, a09, a14, a19, a24);
+            d0 = XOR256(c4, ROL256(c1, 1));
+            d1 = XOR256(c0, ROL256(c2, 1));
+            d2 = XOR256(c1, ROL256(c3, 1));
+            d3 = XOR256(c2, ROL256(c4, 1));
+            d4 = XOR256(c3, ROL256(c0, 1));
+
+            b00 = XOR256(a00, d0);
+            b01 = ROL256(XOR256(a06, d1), 44);
+            b02 = ROL256(XOR256(a12, d2), 43);
+            b03 = ROL256(XOR256(a18, d3), 21);
+            b04 = ROL256(XOR256(a24, d4), 14);
+            b05 = ROL256(XOR256(a03, d3), 28);
+            b06 = ROL256(XOR256(a09, d4), 20);
+            b07 = ROL256(XOR256(a10, d0), 3);
+            b08 = ROL256(XOR256(a16, d1), 45);
+            b09 = ROL256(XOR256(a22, d2), 61);
+            b10 = ROL256(XOR256(a01, d1), 1);
+            b11 = ROL256(XOR256(a07, d2), 6);
+            b12 = ROL256(XOR256(a13, d3), 25);
+            b13 = ROL256(XOR256(a19, d4), 8);
+            b14 = ROL256(XOR256(a20, d0), 18);
+            b15 = ROL256(XOR256(a04, d4), 27);
+            b16 = ROL256(XOR256(a05, d0), 36);
+            b17 = ROL256(XOR256(a11, d1), 10);
+            b18 = ROL256(XOR256(a17, d2), 15);
+            b19 = ROL256(XOR256(a23, d3), 56);
+            b20 = ROL256(XOR256(a02, d2), 62);
+            b21 = ROL256(XOR256(a08, d3), 55);
+            b22 = ROL256(XOR256(a14, d4), 39);
+            b23 = ROL256(XOR256(a15, d0), 41);
+            b24 = ROL256(XOR256(a21, d1), 2);
+
+            a00 = XOR256(b00, _mm256_andnot_si256(b01, b02));
+            a01 = XOR256(b01, _mm256_andnot_si256(b02, b03));
+            a02 = XOR256(b02, _mm256_andnot_si256(b03, b04));
+            a03 = XOR256(b03, _mm256_andnot_si256(b04, b00));
+            a04 = XOR256(b04, _mm256_andnot_si256(b00, b01));
+            a05 = XOR256(b05, _mm256_andnot_si256(b06, b07));
+            a06 = XOR256(b06, _mm256_andnot_si256(b07, b08));
+            a07 = XOR256(b07, _mm256_andnot_si256(b08, b09));
+            a08 = XOR256(b08, _mm256_andnot_si256(b09, b05));
+            a09 = XOR256(b09, _mm256_andnot_si256(b05, b06));
+            a10 = XOR256(b10, _mm256_andnot_si256(b11, b12));
+            a11 = XOR256(b11, _mm256_andnot_si256(b12, b13));
+            a12 = XOR256(b12, _mm256_andnot_si256(b13, b14));
+            a13 = XOR256(b13, _mm256_andnot_si256(b14, b10));
+            a14 = XOR256(b14, _mm256_andnot_si256(b10, b11));
+            a15 = XOR256(b15, _mm256_andnot_si256(b16, b17));
+            a16 = XOR256(b16, _mm256_andnot_si256(b17, b18));
+            a17 = XOR256(b17, _mm256_andnot_si256(b18, b19));
+            a18 = XOR256(b18, _mm256_andnot_si256(b19, b15));
+            a19 = XOR256(b19, _mm256_andnot_si256(b15, b16));
+            a20 = XOR256(b20, _mm256_andnot_si256(b21, b22));
+            a21 = XOR256(b21, _mm256_andnot_si256(b22, b23));
+            a22 = XOR256(b22, _mm256_andnot_si256(b23, b24));
+            a23 = XOR256(b23, _mm256_andnot_si256(b24, b20));
+            a24 = XOR256(b24, _mm256_andnot_si256(b20, b21));
+
+            a00 = XOR256(a00, _mm256_set1_epi64x((long long)sRoundConstants[round]));
+        }
+
+        s[0] = a00; s[1] = a01; s[2] = a02; s[3] = a03; s[4] = a04;
+        s[5] = a05; s[6] = a06; s[7] = a07; s[8] = a08; s[9] = a09;
+        s[10] = a10; s[11] = a11; s[12] = a12; s[13] = a13; s[14] = a14;
+        s[15] = a15; s[16] = a16; s[17] = a17; s[18] = a18; s[19] = a19;
+        s[20] = a20; s[21] = a21; s[22] = a22; s[23] = a23; s[24] = a24;
+    }
+
+    __attribute__((target("avx2")))
+    static void hash4AVX2(const uchar* const data[4], const int size[4], uchar* const out[4])
+    {
+        __m256i state[25];
+        for ( int i = 0; i < 25; i++ ) {
+            state[i] = _mm256_setzero_si256();
+        }
+
+        int blocks[4];
+        int maxBlocks = 0;
+        for ( int k = 0; k < 4; k++ ) {
+            blocks[k] = size[k] / Keccak256::RATE + 1; // the padding always adds a block
+            maxBlocks = qMax(maxBlocks, blocks[k]);
+        }
+
+        uchar padded[4][Keccak256::RATE];
+        static const uchar zeros[Keccak256::RATE] = { 0 };
+
+        for ( int b = 0; b < maxBlocks; b++ ) {
+            const uchar* block[4];
+            for ( int k = 0; k < 4; k++ ) {
+                if ( b < blocks[k] - 1 ) {
+                    block[k] = data[k] + b * Keccak256::RATE;
+                } else if ( b == blocks[k] - 1 ) {
+                    padBlock(data[k] + b * Keccak256::RATE, size[k] - b * Keccak256::RATE, padded[k]);
+                    block[k] = padded[k];
+                } else {
+                    block[k] = zeros; // done, its lanes just keep permuting
+                }
+            }
+
+            for ( int i = 0; i < Keccak256::RATE / 8; i++ ) {
+                const __m256i lanes = _mm256_set_epi64x(
+                            (long long)qFromLittleEndian<quint64>(block[3] + 8 * i),
+                            (long long)qFromLittleEndian<quint64>(block[2] + 8 * i),
+                            (long long)qFromLittleEndian<quint64>(block[1] + 8 * i),
+                            (long long)qFromLittleEndian<quint64>(block[0] + 8 * i));
+                state[i] = XOR256(state[i], lanes);
+            }
+            keccakF1600x4(state);
+
+            for ( int k = 0; k < 4; k++ ) {
+                if ( b == blocks[k] - 1 ) {
+                    quint64 lanes[Keccak256::HASH_SIZE / 8];
+                    for ( int i = 0; i < Keccak256::HASH_SIZE / 8; i++ ) {
+                        quint64 elements[4];
+                        _mm256_storeu_si256((__m256i*)elements, state[i]);
+                        lanes[i] = elements[k];
+                    }
+                    squeeze(lanes, out[k]);
+                }
+            }
+        }
+    }
+
+#undef XOR5
+#undef XOR256
+#undef ROL256
+
+    static bool hasAVX2()
+    {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+    }
+
+    static const bool sUseAVX2 = hasAVX2();
+#else
+    static const bool sUseAVX2 = false;
+#endif
+
+#undef ROL64
+
+    Keccak256::Keccak256()
+    {
+        reset();
+    }
+
+    void Keccak256::reset()
+    {
+        memset(fState, 0, sizeof(fState));
+        fBuffered = 0;
+    }
+
+    void Keccak256::update(const uchar* data, int size)
+    {
+        if ( fBuffered > 0 ) {
+            const int take = qMin(size, RATE - fBuffered);
+            memcpy(fBuffer + fBuffered, data, take);
+            fBuffered += take;
+            data += take;
+            size -= take;
+
+            if ( fBuffered < RATE ) {
+                return;
+            }
+            absorbBlock(fState, fBuffer);
+            fBuffered = 0;
+        }
+
+        while ( size >= RATE ) {
+            absorbBlock(fState, data);
+            data += RATE;
+            size -= RATE;
+        }
+
+        memcpy(fBuffer, data, size);
+        fBuffered = size;
+    }
+
+    void Keccak256::update(const QByteArray& data)
+    {
+        update((const uchar*)data.constData(), data.size());
+    }
+
+    void Keccak256::digest(uchar* out)
+    {
+        uchar block[RATE];
+        padBlock(fBuffer, fBuffered, block);
+        absorbBlock(fState, block);
+        squeeze(fState, out);
+        reset();
+    }
+
+    const QByteArray Keccak256::digest()
+    {
+        QByteArray result(HASH_SIZE, Qt::Uninitialized);
+        digest((uchar*)result.data());
+        return result;
+    }
+
+    void Keccak256::hash(const uchar* data, int size, uchar* out)
+    {
+        Keccak256 keccak;
+        keccak.update(data, size);
+        keccak.digest(out);
+    }
+
+    const QByteArray Keccak256::hash(const QByteArray& data)
+    {
+        Keccak256 keccak;
+        keccak.update(data);
+        return keccak.digest();
+    }
+
+    void Keccak256::hash4(const uchar* const data[4], const int size[4], uchar* const out[4])
+    {
+#ifdef KECCAK_X86
+        if ( sUseAVX2 ) {
+            return hash4AVX2(data, size, out);
+        }
+#endif
+        for ( int k = 0; k < 4; k++ ) {
+            hash(data[k], size[k], out[k]);
+        }
+    }
+
+    const QList<QByteArray> Keccak256::hashMany(const QList<QByteArray>& data)
+    {
+        QList<QByteArray> result;
+        result.reserve(data.size());
+
+        for ( int first = 0; first < data.size(); first += 4 ) {
+            const uchar* in[4];
+            int size[4];
+            uchar* out[4];
+            QByteArray hashes[4];
+
+            for ( int k = 0; k < 4; k++ ) {
+                const QByteArray& item = data.at(qMin(first + k, data.size() - 1)); // a short last group repeats its tail
+                in[k] = (const uchar*)item.constData();
+                size[k] = item.size();
+                hashes[k] = QByteArray(HASH_SIZE, Qt::Uninitialized);
+                out[k] = (uchar*)hashes[k].data();
+            }
+
+            hash4(in, size, out);
+            for ( int k = 0; k < 4 && first + k < data.size(); k++ ) {
+                result.append(hashes[k]);
+            }
+        }
+
+        return result;
+    }
+
+    const char* Keccak256::kernelName()
+    {
+        return sUseAVX2 ? "avx2" : "scalar";
+    }
+
+}
@@ -2,42 +2,39 @@
 #define KECCAK_H
 
 #include <QtGlobal>
+#include <QByteArray>
+#include <QList>
+
+namespace Dubaicoin {
+
+    // Keccak-256 with the original 0x01 padding used for selectors, topics and tx
+    // hashes, which is not the FIPS 202 SHA3-256 that QCryptographicHash::Sha3_256 gives
+    class Keccak256
+    {
+    public:
+        static const int HASH_SIZE = 32;
+        static const int RATE = 136; // bytes absorbed per permutation
+
+        Keccak256();
+
+        void reset();
+        void update(const uchar* data, int size);
+        void update(const QByteArray& data);
+        void digest(uchar* out); // writes HASH_SIZE bytes and resets for the next message
+        const QByteArray digest();
+
+        static void hash(const uchar* data, int size, uchar* out);
+        static const QByteArray hash(const QByteArray& data);
+        // four independent messages in one pass, 4-way AVX2 when the CPU has it
+        static void hash4(const uchar* const data[4], const int size[4], uchar* const out[4]);
+        static const QList<QByteArray> hashMany(const QList<QByteArray>& data);
+        static const char* kernelName(); // "avx2" or "scalar"
+    private:
+        quint64 fState[25];
+        uchar fBuffer[RATE];
+        int fBuffered;
+    };
 
-// ORIGIN: https://github.com/gvanas/KeccakCodePackage
-
-#define FOR(i,n) for(i=0; i<n; ++i)
-typedef unsigned char u8;
-typedef unsigned long long int u64;
-typedef unsigned int ui;
-
-void Keccak(ui r, ui c, const u8 *in, u64 inLen, u8 sfx, u8 *out, u64 outLen);
-void FIPS202_KECCAK_256(const u8 *in, u64 inLen, u8 *out) { Keccak(1088, 512, in, inLen, 0x01, out, 32); }
-
-int LFSR86540(u8 *R) { (*R)=((*R)<<1)^(((*R)&0x80)?0x71:0); return ((*R)&2)>>1; }
-#define ROL(a,o) ((((u64)a)<<o)^(((u64)a)>>(64-o)))
-static u64 load64(const u8 *x) { ui i; u64 u=0; FOR(i,8) { u<<=8; u|=x[7-i]; } return u; }
-static void store64(u8 *x, u64 u) { ui i; FOR(i,8) { x[i]=u; u>>=8; } }
-static void xor64(u8 *x, u64 u) { ui i; FOR(i,8) { x[i]^=u; u>>=8; } }
-#define rL(x,y) load64((u8*)s+8*(x+5*y))
-#define wL(x,y,l) store64((u8*)s+8*(x+5*y),l)
-#define XL(x,y,l) xor64((u8*)s+8*(x+5*y),l)
-void KeccakF1600(void *s)
-{
-    ui r,x,y,i,j,Y; u8 R=0x01; u64 C[5],D;
-    for(i=0; i<24; i++) {
-        /*θ*/ FOR(x,5) C[x]=rL(x,0)^rL(x,1)^rL(x,2)^rL(x,3)^rL(x,4); FOR(x,5) { D=C[(x+4)%5]^ROL(C[(x+1)%5],1); FOR(y,5) XL(x,y,D); }
-        /*ρπ*/ x=1; y=r=0; D=rL(x,y); FOR(j,24) { r+=j+1; Y=(2*x+3*y)%5; x=y; y=Y; C[0]=rL(x,y); wL(x,y,ROL(D,r%64)); D=C[0]; }
-        /*χ*/ FOR(y,5) { FOR(x,5) C[x]=rL(x,y); FOR(x,5) wL(x,y,C[x]^((~C[(x+1)%5])&C[(x+2)%5])); }
-        /*ι*/ FOR(j,7) if (LFSR86540(&R)) XL(0,0,(u64)1<<((1<<j)-1));
-    }
-}
-void Keccak(ui r, ui c, const u8 *in, u64 inLen, u8 sfx, u8 *out, u64 outLen)
-{
-    Q_UNUSED(c);
-    /*initialize*/ u8 s[200]; ui R=r/8; ui i,b=0; FOR(i,200) s[i]=0;
-    /*absorb*/ while(inLen>0) { b=(inLen<R)?inLen:R; FOR(i,b) s[i]^=in[i]; in+=b; inLen-=b; if (b==R) { KeccakF1600(s); b=0; } }
-    /*pad*/ s[b]^=sfx; if((sfx&0x80)&&(b==(R-1))) KeccakF1600(s); s[R-1]^=0x80; KeccakF1600(s);
-    /*squeeze*/ while(outLen>0) { b=(outLen<R)?outLen:R; FOR(i,b) out[i]=s[i]; out+=b; outLen-=b; if(outLen>0) KeccakF1600(s); }
 }
 
 #endif // KECCAK_H
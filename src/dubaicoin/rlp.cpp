@@ -0,0 +1,290 @@
+#include "rlp.h"
+#include <cstring>
+
+namespace Dubaicoin {
+
+    using Dbixwall::UInt256;
+
+    static int lengthBytes(int size)
+    {
+        int result = 0;
+        while ( size > 0 ) {
+            size >>= 8;
+            result++;
+        }
+
+        return result;
+    }
+
+    static int headerSize(int payloadSize)
+    {
+        return payloadSize <= 55 ? 1 : 1 + lengthBytes(payloadSize);
+    }
+
+    // big endian value bytes in the tail of buffer, returns how many are significant
+    static int uintBytes(const UInt256& value, uchar* buffer)
+    {
+        for ( int i = 0; i < 32; i++ ) {
+            buffer[31 - i] = (uchar)(value.limb(i / 8) >> (8 * (i % 8)));
+        }
+
+        return (value.bitLength() + 7) / 8;
+    }
+
+    // *************************** RLPWriter **************************** //
+
+    RLPWriter::RLPWriter(uchar* out) :
+        fBegin(out), fPos(out)
+    {
+    }
+
+    int RLPWriter::stringSize(const uchar* data, int size)
+    {
+        if ( size == 1 && data[0] < 0x80 ) { // single byte is its own encoding
+            return 1;
+        }
+
+        return headerSize(size) + size;
+    }
+
+    int RLPWriter::stringSize(const QByteArray& data)
+    {
+        return stringSize((const uchar*)data.constData(), data.size());
+    }
+
+    int RLPWriter::uintSize(const UInt256& value)
+    {
+        const int size = (value.bitLength() + 7) / 8;
+        if ( size == 1 && value.limb(0) < 0x80 ) {
+            return 1;
+        }
+
+        return 1 + size; // at most 32 bytes, always a short header
+    }
+
+    int RLPWriter::listSize(int payloadSize)
+    {
+        return headerSize(payloadSize) + payloadSize;
+    }
+
+    void RLPWriter::writeString(const uchar* data, int size)
+    {
+        if ( size == 1 && data[0] < 0x80 ) {
+            *fPos++ = data[0];
+            return;
+        }
+
+        writeHeader(0x80, size);
+        if ( size > 0 ) {
+            memcpy(fPos, data, size);
+            fPos += size;
+        }
+    }
+
+    void RLPWriter::writeString(const QByteArray& data)
+    {
+        writeString((const uchar*)data.constData(), data.size());
+    }
+
+    void RLPWriter::writeUInt(const UInt256& value)
+    {
+        uchar buffer[32];
+        const int size = uintBytes(value, buffer);
+        writeString(buffer + 32 - size, size);
+    }
+
+    void RLPWriter::writeListHeader(int payloadSize)
+    {
+        writeHeader(0xc0, payloadSize);
+    }
+
+    int RLPWriter::size() const
+    {
+        return fPos - fBegin;
+    }
+
+    void RLPWriter::writeHeader(uchar shortBase, int size)
+    {
+        if ( size <= 55 ) {
+            *fPos++ = shortBase + size;
+            return;
+        }
+
+        const int count = lengthBytes(size);
+        *fPos++ = shortBase + 55 + count;
+        for ( int i = count - 1; i >= 0; i-- ) {
+            *fPos++ = (uchar)(size >> (8 * i));
+        }
+    }
+
+    // *************************** RLPReader **************************** //
+
+    RLPReader::RLPReader() :
+        fPos(0), fEnd(0), fFailed(false)
+    {
+    }
+
+    RLPReader::RLPReader(const uchar* data, int size) :
+        fPos(data), fEnd(data + size), fFailed(false)
+    {
+    }
+
+    RLPReader::RLPReader(const QByteArray& data) :
+        fPos((const uchar*)data.constData()), fEnd((const uchar*)data.constData() + data.size()), fFailed(false)
+    {
+    }
+
+    bool RLPReader::atEnd() const
+    {
+        return fPos >= fEnd;
+    }
+
+    bool RLPReader::failed() const
+    {
+        return fFailed;
+    }
+
+    bool RLPReader::isList() const
+    {
+        return !fFailed && fPos < fEnd && *fPos >= 0xc0;
+    }
+
+    bool RLPReader::enterList(RLPReader& items)
+    {
+        bool list = false;
+        const uchar* payload = 0;
+        int size = 0;
+        if ( !readItem(list, payload, size) ) {
+            return false;
+        }
+
+        if ( !list ) {
+            return fail();
+        }
+
+        items = RLPReader(payload, size);
+        return true;
+    }
+
+    bool RLPReader::readString(const uchar*& data, int& size)
+    {
+        bool list = false;
+        if ( !readItem(list, data, size) ) {
+            return false;
+        }
+
+        return list ? fail() : true;
+    }
+
+    bool RLPReader::readString(QByteArray& data)
+    {
+        const uchar* view = 0;
+        int size = 0;
+        if ( !readString(view, size) ) {
+            return false;
+        }
+
+        data = QByteArray((const char*)view, size);
+        return true;
+    }
+
+    bool RLPReader::readUInt(UInt256& value)
+    {
+        const uchar* data = 0;
+        int size = 0;
+        if ( !readString(data, size) ) {
+            return false;
+        }
+
+        if ( size > 32 || ( size > 0 && data[0] == 0 ) ) { // integers have no leading zeros
+            return fail();
+        }
+
+        quint64 limbs[4] = { 0, 0, 0, 0 };
+        for ( int i = 0; i < size; i++ ) {
+            const int shift = size - 1 - i; // byte index from the least significant end
+            limbs[shift / 8] |= (quint64)data[i] << (8 * (shift % 8));
+        }
+
+        value = (UInt256(limbs[3]) << 192) + (UInt256(limbs[2]) << 128) + (UInt256(limbs[1]) << 64) + UInt256(limbs[0]);
+        return true;
+    }
+
+    bool RLPReader::readUInt(quint64& value)
+    {
+        UInt256 full;
+        if ( !readUInt(full) ) {
+            return false;
+        }
+
+        if ( !full.fitsUInt64() ) {
+            return fail();
+        }
+
+        value = full.toUInt64();
+        return true;
+    }
+
+    bool RLPReader::skip()
+    {
+        bool list = false;
+        const uchar* payload = 0;
+        int size = 0;
+        return readItem(list, payload, size);
+    }
+
+    bool RLPReader::readItem(bool& list, const uchar*& payload, int& size)
+    {
+        if ( fFailed || fPos >= fEnd ) {
+            return fail();
+        }
+
+        const uchar prefix = *fPos++;
+        if ( prefix < 0x80 ) { // single byte string
+            list = false;
+            payload = fPos - 1;
+            size = 1;
+            return true;
+        }
+
+        list = prefix >= 0xc0;
+        const uchar base = list ? 0xc0 : 0x80;
+        if ( prefix - base <= 55 ) {
+            size = prefix - base;
+        } else {
+            const int count = prefix - base - 55;
+            if ( count > 4 || count > fEnd - fPos || *fPos == 0 ) { // lengths have no leading zeros either
+                return fail();
+            }
+
+            quint64 length = 0;
+            for ( int i = 0; i < count; i++ ) {
+                length = (length << 8) | *fPos++;
+            }
+
+            if ( length <= 55 || length > (quint64)(fEnd - fPos) ) { // should have used the short form
+                return fail();
+            }
+            size = (int)length;
+        }
+
+        if ( size > fEnd - fPos ) {
+            return fail();
+        }
+
+        if ( !list && size == 1 && *fPos < 0x80 ) { // should have been a single byte
+            return fail();
+        }
+
+        payload = fPos;
+        fPos += size;
+        return true;
+    }
+
+    bool RLPReader::fail()
+    {
+        fFailed = true;
+        return false;
+    }
+
+}
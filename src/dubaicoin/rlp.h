@@ -0,0 +1,64 @@
+#ifndef RLP_H
+#define RLP_H
+
+#include <QtGlobal>
+#include <QByteArray>
+#include "uint256.h"
+
+namespace Dubaicoin {
+
+    // single pass RLP encoder into a caller allocated buffer. Callers sum up the
+    // *Size() of their items first so the buffer is allocated once at its exact size.
+    class RLPWriter
+    {
+    public:
+        RLPWriter(uchar* out);
+
+        static int stringSize(const uchar* data, int size);
+        static int stringSize(const QByteArray& data);
+        static int uintSize(const Dbixwall::UInt256& value);
+        static int listSize(int payloadSize); // header included
+
+        void writeString(const uchar* data, int size);
+        void writeString(const QByteArray& data);
+        void writeUInt(const Dbixwall::UInt256& value); // big endian without leading zeros, 0 is the empty string
+        void writeListHeader(int payloadSize);
+        int size() const; // bytes written so far
+    private:
+        uchar* fBegin;
+        uchar* fPos;
+
+        void writeHeader(uchar shortBase, int size);
+    };
+
+    // zero copy RLP decoder, strings are returned as views into the source buffer
+    // which has to outlive the reader. Any malformed or non canonical input fails
+    // the reader for good and every further read returns false.
+    class RLPReader
+    {
+    public:
+        RLPReader();
+        RLPReader(const uchar* data, int size);
+        RLPReader(const QByteArray& data);
+
+        bool atEnd() const;
+        bool failed() const;
+        bool isList() const; // next item is a list
+        bool enterList(RLPReader& items); // reader over the list payload, skips past it here
+        bool readString(const uchar*& data, int& size);
+        bool readString(QByteArray& data); // deep copy
+        bool readUInt(Dbixwall::UInt256& value);
+        bool readUInt(quint64& value);
+        bool skip();
+    private:
+        const uchar* fPos;
+        const uchar* fEnd;
+        bool fFailed;
+
+        bool readItem(bool& list, const uchar*& payload, int& size);
+        bool fail();
+    };
+
+}
+
+#endif // RLP_H
@@ -1,10 +1,15 @@
 #include "tx.h"
 #include "helpers.h"
-#include <QList>
+#include "hexcodec.h"
+#include "keccak.h"
+#include "rlp.h"
 
 namespace Dubaicoin {
 
-    Tx::Tx()
+    using Dbixwall::UInt256;
+
+    Tx::Tx() :
+        fNonce(0), fV(0), fDataIndex(0)
     {
 
     }
@@ -70,7 +75,7 @@ namespace Dubaicoin {
     const std::string Tx::toBytes() const
     {
         const QString hex = Dbixwall::Helpers::clearHexPrefix(fTo);
-        const QByteArray bytes = QByteArray::fromHex(hex.toUtf8());
+        const QByteArray bytes = Dbixwall::HexCodec::fromHex(hex);
 
         return bytes.toStdString();
     }
@@ -93,7 +98,7 @@ namespace Dubaicoin {
     const std::string Tx::valueBytes() const
     {
         const QString hex = Dbixwall::Helpers::clearHexPrefix(Dbixwall::Helpers::toHexWeiStr(fValue));
-        const QByteArray bytes = QByteArray::fromHex(hex.toUtf8());
+        const QByteArray bytes = Dbixwall::HexCodec::fromHex(hex);
 
         return bytes.toStdString();
     }
@@ -111,7 +116,7 @@ namespace Dubaicoin {
     const std::string Tx::gasBytes() const
     {
         const QString hex = Dbixwall::Helpers::clearHexPrefix(Dbixwall::Helpers::decStrToHexStr(fGas));
-        const QByteArray bytes = QByteArray::fromHex(hex.toUtf8());
+        const QByteArray bytes = Dbixwall::HexCodec::fromHex(hex);
 
         return bytes.toStdString();
     }
@@ -129,7 +134,7 @@ namespace Dubaicoin {
     const std::string Tx::gasPriceBytes() const
     {
         const QString hex = Dbixwall::Helpers::clearHexPrefix(Dbixwall::Helpers::toHexWeiStr(fGasPrice));
-        const QByteArray bytes = QByteArray::fromHex(hex.toUtf8());
+        const QByteArray bytes = Dbixwall::HexCodec::fromHex(hex);
 
         return bytes.toStdString();
     }
@@ -142,7 +147,7 @@ namespace Dubaicoin {
     const std::string Tx::nonceBytes() const
     {
         const QString nonceHex = Dbixwall::Helpers::clearHexPrefix(Dbixwall::Helpers::toHexStr(fNonce)); // big endian hex string
-        const QByteArray nonceBytes = QByteArray::fromHex(nonceHex.toUtf8());
+        const QByteArray nonceBytes = Dbixwall::HexCodec::fromHex(nonceHex);
 
         return nonceBytes.toStdString();
     }
@@ -158,7 +163,7 @@ namespace Dubaicoin {
             return 0;
         }
 
-        return QByteArray::fromHex(Dbixwall::Helpers::clearHexPrefix(fData).toUtf8()).size();
+        return Dbixwall::HexCodec::fromHex(Dbixwall::Helpers::clearHexPrefix(fData)).size();
     }
 
     const QString Tx::dataStr() const
@@ -173,7 +178,7 @@ namespace Dubaicoin {
 
     const std::string Tx::dataBytes(quint32 index, quint16 size) const
     {
-        const QByteArray allBytes = QByteArray::fromHex(Dbixwall::Helpers::clearHexPrefix(fData).toUtf8());
+        const QByteArray allBytes = Dbixwall::HexCodec::fromHex(Dbixwall::Helpers::clearHexPrefix(fData));
         if ( index >= (quint32) allBytes.size() ) {
             return std::string();
         }
@@ -202,7 +207,7 @@ namespace Dubaicoin {
     const std::string Tx::vBytes() const
     {
         const QString hex = Dbixwall::Helpers::clearHexPrefix(Dbixwall::Helpers::toHexStr(fV)); // big endian hex string
-        const QByteArray bytes = QByteArray::fromHex(hex.toUtf8());
+        const QByteArray bytes = Dbixwall::HexCodec::fromHex(hex);
 
         return bytes.toStdString();
     }
@@ -219,77 +224,133 @@ namespace Dubaicoin {
 
     const QString Tx::encodeRLP(bool withSignature) const
     {
-        QList<QByteArray> innerRLPs;
-        innerRLPs.append(encodeRLPString(nonceBytes())); // nonce
-        innerRLPs.append(encodeRLPString(gasPriceBytes())); // gas price
-        innerRLPs.append(encodeRLPString(gasBytes())); // gas limit
-        innerRLPs.append(encodeRLPString(toBytes())); // to addr
-        innerRLPs.append(encodeRLPString(valueBytes())); // value
-        innerRLPs.append(encodeRLPString(dataBytes(0, dataByteSize()))); // data
+        return Dbixwall::HexCodec::toHex(encodeRLPBytes(withSignature));
+    }
 
-        if ( withSignature ) {
-            innerRLPs.append(encodeRLPString(vBytes())); // signature/v
-            innerRLPs.append(encodeRLPString(rBytes())); // signature/r
-            innerRLPs.append(encodeRLPString(sBytes())); // signature/s
-        }
+    const QByteArray Tx::signingHash() const
+    {
+        return Keccak256::hash(encodeRLPBytes(false));
+    }
 
-        int totalSize = 0;
-        foreach ( const QByteArray item, innerRLPs ) {
-            totalSize += item.size();
-        }
+    const QByteArray Tx::hash() const
+    {
+        return Keccak256::hash(encodeRLPBytes(true));
+    }
 
-        QByteArray result;
-        foreach ( const QByteArray item, innerRLPs ) {
-            result += item;
+    // sizes every field first so the whole transaction is written into one exact buffer
+    const QByteArray Tx::encodeRLPBytes(bool withSignature) const
+    {
+        const UInt256 nonce(fNonce);
+        const UInt256 gasPrice = UInt256::fromDecimal(fGasPrice, 18);
+        const UInt256 gas = UInt256::fromDec(fGas);
+        const QByteArray to = Dbixwall::HexCodec::fromHex(Dbixwall::Helpers::clearHexPrefix(fTo));
+        const UInt256 value = UInt256::fromDecimal(fValue, 18);
+        const QByteArray data = hasData() ? Dbixwall::HexCodec::fromHex(Dbixwall::Helpers::clearHexPrefix(fData)) : QByteArray();
+        const UInt256 v(fV);
+        const QByteArray r = withoutLeadingZeros(fR);
+        const QByteArray s = withoutLeadingZeros(fS);
+
+        int payloadSize = RLPWriter::uintSize(nonce) + RLPWriter::uintSize(gasPrice) + RLPWriter::uintSize(gas) +
+                          RLPWriter::stringSize(to) + RLPWriter::uintSize(value) + RLPWriter::stringSize(data);
+        if ( withSignature ) {
+            payloadSize += RLPWriter::uintSize(v) + RLPWriter::stringSize(r) + RLPWriter::stringSize(s);
         }
 
-        if ( totalSize <= 55 ) {
-            result.prepend(0xc0 + totalSize);
+        QByteArray result(RLPWriter::listSize(payloadSize), Qt::Uninitialized);
+        RLPWriter writer((uchar*)result.data());
+        writer.writeListHeader(payloadSize);
+        writer.writeUInt(nonce);
+        writer.writeUInt(gasPrice);
+        writer.writeUInt(gas); // gas limit
+        writer.writeString(to);
+        writer.writeUInt(value);
+        writer.writeString(data);
 
-            return result.toHex();
+        if ( withSignature ) {
+            writer.writeUInt(v);
+            writer.writeString(r);
+            writer.writeString(s);
         }
 
-        QByteArray binLength = lengthToBinary(totalSize);
-        binLength.prepend(0xf7 + binLength.size());
-        return (binLength + result).toHex();
+        return result;
     }
 
-    const QString Tx::toString() const
+    const Tx Tx::fromRLP(const QByteArray& raw, bool* ok)
     {
-        return "from: " + fFrom + " to: " + fTo + " value: " + fValue + " nonce: " + fNonce + " gas: " + fGas + " gasPrice: " + fGasPrice + " data: " + fData + " v: " + fV + " r: " + fR.toHex() + " s: " + fS.toHex();
-    }
+        Tx result;
+        if ( ok != 0 ) {
+            *ok = false;
+        }
 
-    const QByteArray Tx::encodeRLPString(const std::string &bytes) const
-    {
-        QByteArray native = QByteArray::fromStdString(bytes);
+        RLPReader reader(raw);
+        RLPReader items;
+        if ( !reader.enterList(items) || !reader.atEnd() ) {
+            return result;
+        }
+
+        quint64 nonce = 0;
+        UInt256 gasPrice;
+        UInt256 gas;
+        const uchar* to = 0;
+        int toSize = 0;
+        UInt256 value;
+        const uchar* data = 0;
+        int dataSize = 0;
+        if ( !items.readUInt(nonce) || !items.readUInt(gasPrice) || !items.readUInt(gas) ||
+             !items.readString(to, toSize) || !items.readUInt(value) || !items.readString(data, dataSize) ) {
+            return result;
+        }
+
+        if ( toSize != 0 && toSize != 20 ) {
+            return result;
+        }
 
-        if ( native.size() == 1 && (quint8) native.at(0) <= 0x7f ) { // single byte case
-            // 0 is not 0x00 because of https://forum.dubaicoin.org/discussion/1657/why-should-rlp-0-be-0x80
-            if ( native.at(0) == 0 ) {
-                native[0] = 0x80;
+        quint64 v = 0;
+        QByteArray r;
+        QByteArray s;
+        if ( !items.atEnd() ) { // signed
+            if ( !items.readUInt(v) || v > 0xffffffff || !items.readString(r) || !items.readString(s) ) {
+                return result;
             }
-            return native;
         }
 
-        if ( native.size() <= 55 ) {
-            quint8 size = native.size() + 0x80;
-            native.prepend(size);
-            return native;
+        if ( !items.atEnd() || r.size() > 32 || s.size() > 32 ) {
+            return result;
+        }
+
+        const QString toHex = toSize > 0 ? "0x" + QString(Dbixwall::HexCodec::toHex(QByteArray::fromRawData((const char*)to, toSize))) : QString();
+        const QString dataHex = dataSize > 0 ? "0x" + QString(Dbixwall::HexCodec::toHex(QByteArray::fromRawData((const char*)data, dataSize))) : QString();
+        result.init(QString(), toHex, value.toDec(18), nonce, gas.toDec(), gasPrice.toDec(18), dataHex);
+        if ( !r.isEmpty() || !s.isEmpty() ) {
+            result.sign((quint32)v, (QByteArray(32 - r.size(), '\0') + r).toStdString(), (QByteArray(32 - s.size(), '\0') + s).toStdString());
+        }
+
+        if ( ok != 0 ) {
+            *ok = true;
         }
 
-        // full > 55 bytes size
-        QByteArray binLength = lengthToBinary(native.size());
-        binLength.prepend(0xb7 + binLength.size());
-        return binLength + native;
+        return result;
     }
 
-    const QByteArray Tx::lengthToBinary(quint32 length) const
+    const Tx Tx::fromRLPHex(const QString& hex, bool* ok)
+    {
+        return fromRLP(Dbixwall::HexCodec::fromHex(Dbixwall::Helpers::clearHexPrefix(hex)), ok);
+    }
+
+    const QString Tx::toString() const
     {
-        if ( length == 0 ) {
-            return QByteArray();
-        } else {
-            return lengthToBinary(length / 256) + char(length % 256);
+        return "from: " + fFrom + " to: " + fTo + " value: " + fValue + " nonce: " + QString::number(fNonce) + " gas: " + fGas + " gasPrice: " + fGasPrice + " data: " + fData + " v: " + QString::number(fV) + " r: " + fR.toHex() + " s: " + fS.toHex();
+    }
+
+    // r and s are RLP integers, returns a view without the leading zero bytes
+    const QByteArray Tx::withoutLeadingZeros(const QByteArray& bytes)
+    {
+        int first = 0;
+        while ( first < bytes.size() && bytes.at(first) == 0 ) {
+            first++;
         }
+
+        return QByteArray::fromRawData(bytes.constData() + first, bytes.size() - first);
     }
 
 }
@@ -60,7 +60,11 @@ namespace Dubaicoin {
         const std::string rBytes() const;
         const std::string sBytes() const;
 
-        const QString encodeRLP(bool withSignature = true) const;
+        const QString encodeRLP(bool withSignature = true) const; // hex for eth_sendRawTransaction
+        static const Tx fromRLP(const QByteArray& raw, bool* ok = 0); // legacy, signed or not, from stays empty
+        static const Tx fromRLPHex(const QString& hex, bool* ok = 0); // optional 0x prefix, eth_getRawTransaction*
+        const QByteArray signingHash() const; // keccak of the unsigned RLP
+        const QByteArray hash() const; // keccak of the signed RLP, the transaction hash
         const QString toString() const;
     private:
         QString fFrom;
@@ -75,8 +79,8 @@ namespace Dubaicoin {
         QByteArray fS;
         int fDataIndex;
 
-        const QByteArray encodeRLPString(const std::string& bytes) const;
-        const QByteArray lengthToBinary(quint32 length) const;
+        const QByteArray encodeRLPBytes(bool withSignature) const;
+        static const QByteArray withoutLeadingZeros(const QByteArray& bytes);
     };
 
 }
@@ -0,0 +1,101 @@
+/*
+    This file is part of dbixwall.
+    dbixwall is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    dbixwall is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with dbixwall. If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file fixeddecimal.cpp
+ * @date 2026
+ *
+ * Fixed point decimal with 18 fractional digits
+ */
+
+#include "fixeddecimal.h"
+
+namespace Dbixwall {
+
+    FixedDecimal::FixedDecimal() : fRaw()
+    {
+    }
+
+    const FixedDecimal FixedDecimal::fromInteger(quint64 whole) {
+        return fromRaw(UInt256(whole) * UInt256(scale()));
+    }
+
+    const FixedDecimal FixedDecimal::fromRaw(const UInt256& raw) {
+        FixedDecimal result;
+        result.fRaw = raw;
+        return result;
+    }
+
+    const FixedDecimal FixedDecimal::fromString(const QString& text, bool* ok) {
+        return fromRaw(UInt256::fromDecimal(text, DECIMALS, ok));
+    }
+
+    const UInt256& FixedDecimal::raw() const {
+        return fRaw;
+    }
+
+    const QString FixedDecimal::toString() const {
+        return fRaw.toDec(DECIMALS);
+    }
+
+    double FixedDecimal::toDouble() const {
+        double result = 0;
+        for ( int i = 3; i >= 0; i-- ) {
+            result = result * 18446744073709551616.0 + (double)fRaw.limb(i); // 2^64
+        }
+
+        return result / scale();
+    }
+
+    bool FixedDecimal::isZero() const {
+        return fRaw.isZero();
+    }
+
+    const FixedDecimal FixedDecimal::operator+(const FixedDecimal& other) const {
+        return fromRaw(fRaw + other.fRaw);
+    }
+
+    const FixedDecimal FixedDecimal::operator-(const FixedDecimal& other) const {
+        return fromRaw(fRaw - other.fRaw);
+    }
+
+    const FixedDecimal FixedDecimal::operator*(const FixedDecimal& other) const {
+        return fromRaw(fRaw * other.fRaw / UInt256(scale()));
+    }
+
+    FixedDecimal& FixedDecimal::operator+=(const FixedDecimal& other) {
+        fRaw += other.fRaw;
+        return *this;
+    }
+
+    FixedDecimal& FixedDecimal::operator-=(const FixedDecimal& other) {
+        fRaw -= other.fRaw;
+        return *this;
+    }
+
+    bool FixedDecimal::operator==(const FixedDecimal& other) const {
+        return fRaw == other.fRaw;
+    }
+
+    bool FixedDecimal::operator!=(const FixedDecimal& other) const {
+        return fRaw != other.fRaw;
+    }
+
+    bool FixedDecimal::operator<(const FixedDecimal& other) const {
+        return fRaw < other.fRaw;
+    }
+
+    bool FixedDecimal::operator>(const FixedDecimal& other) const {
+        return fRaw > other.fRaw;
+    }
+
+}
@@ -0,0 +1,63 @@
+/*
+    This file is part of dbixwall.
+    dbixwall is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    dbixwall is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with dbixwall. If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file fixeddecimal.h
+ * @date 2026
+ *
+ * Fixed point decimal with 18 fractional digits header
+ */
+
+#ifndef FIXEDDECIMAL_H
+#define FIXEDDECIMAL_H
+
+#include <QString>
+#include "uint256.h"
+
+namespace Dbixwall {
+
+    // unsigned decimal kept as an integer count of 10^-18 units, so a DBIX amount is
+    // stored as its wei value and every conversion is exact integer math
+    class FixedDecimal
+    {
+    public:
+        static const int DECIMALS = 18;
+        static Q_DECL_CONSTEXPR quint64 scale() { return powerOfTen(DECIMALS); }
+
+        FixedDecimal();
+
+        static const FixedDecimal fromInteger(quint64 whole);
+        static const FixedDecimal fromRaw(const UInt256& raw); // wei for DBIX amounts
+        static const FixedDecimal fromString(const QString& text, bool* ok = 0); // "1.5", extra decimals are cut off
+
+        const UInt256& raw() const;
+        const QString toString() const; // always with all 18 decimals
+        double toDouble() const; // display only
+        bool isZero() const;
+
+        const FixedDecimal operator+(const FixedDecimal& other) const;
+        const FixedDecimal operator-(const FixedDecimal& other) const;
+        const FixedDecimal operator*(const FixedDecimal& other) const; // truncated to 18 decimals
+        FixedDecimal& operator+=(const FixedDecimal& other);
+        FixedDecimal& operator-=(const FixedDecimal& other);
+
+        bool operator==(const FixedDecimal& other) const;
+        bool operator!=(const FixedDecimal& other) const;
+        bool operator<(const FixedDecimal& other) const;
+        bool operator>(const FixedDecimal& other) const;
+    private:
+        UInt256 fRaw;
+    };
+
+}
+
+#endif // FIXEDDECIMAL_H
@@ -3,6 +3,7 @@
 #include <QSettings>
 #include <QApplication>
 #include <QClipboard>
+#include <QThread>
 
 namespace Dbixwall {
 
@@ -38,28 +39,38 @@ namespace Dbixwall {
 
     void GdbixLog::attach(QProcess* process) {
         fProcess = process;
-        connect(fProcess, &QProcess::readyReadStandardOutput, this, &GdbixLog::readStdout);
-        connect(fProcess, &QProcess::readyReadStandardError, this, &GdbixLog::readStderr);
+        // the process lives on the IPC thread, read it there and hand lines over to ours
+        connect(fProcess, &QProcess::readyReadStandardOutput, this, &GdbixLog::readStdout, Qt::DirectConnection);
+        connect(fProcess, &QProcess::readyReadStandardError, this, &GdbixLog::readStderr, Qt::DirectConnection);
     }
 
     void GdbixLog::append(const QString& line) {
+        if ( QThread::currentThread() != thread() ) {
+            QMetaObject::invokeMethod(this, "append", Qt::QueuedConnection, Q_ARG(QString, line));
+            return;
+        }
+
         fList.append(line);
     }
 
     void GdbixLog::readStdout() {
         const QByteArray ba = fProcess->readAllStandardOutput();
-        const QString str = QString::fromUtf8(ba);
-        beginInsertRows(QModelIndex(), 0, 0);
-        fList.insert(0, str);
-        endInsertRows();
-        overflowCheck();
+        insertLine(QString::fromUtf8(ba));
     }
 
     void GdbixLog::readStderr() {
         const QByteArray ba = fProcess->readAllStandardError();
-        const QString str = QString::fromUtf8(ba);
+        insertLine(QString::fromUtf8(ba));
+    }
+
+    void GdbixLog::insertLine(const QString& line) {
+        if ( QThread::currentThread() != thread() ) {
+            QMetaObject::invokeMethod(this, "insertLine", Qt::QueuedConnection, Q_ARG(QString, line));
+            return;
+        }
+
         beginInsertRows(QModelIndex(), 0, 0);
-        fList.insert(0, str);
+        fList.insert(0, line);
         endInsertRows();
         overflowCheck();
     }
@@ -20,7 +20,10 @@ namespace Dbixwall {
         QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const;
         Q_INVOKABLE void saveToClipboard() const;
         void attach(QProcess* process);
+    public slots:
         void append(const QString& line);
+    private slots:
+        void insertLine(const QString& line);
     private:
         QStringList fList;
         QProcess* fProcess;
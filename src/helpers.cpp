@@ -1,18 +1,50 @@
 #include "helpers.h"
 #include "dbixlog.h"
+#include "transactionstore.h"
 #include "dubaicoin/keccak.h"
 #include <QJsonParseError>
-#include <QCryptographicHash>
 #include <QBitArray>
 #include <QDataStream>
 #include <QSettings>
 #include <QFile>
 #include <QDataStream>
+#include <QCache>
+#include <QMutex>
+#include <QHash>
 
 namespace Dbixwall {
 
 // ***************************** Helpers ***************************** //
 
+    // checksummed addresses keyed by their lowercase hex body. Bounded so that decoding
+    // a long log history can't grow it forever, shared by the IPC and GUI threads.
+    static const int ADDRESS_CACHE_SIZE = 4096;
+    static QCache<QString, QString> sAddressCache(ADDRESS_CACHE_SIZE);
+    static QMutex sAddressCacheMutex;
+
+    // lowercase 40 character hex part of an address, empty if it's not one
+    static const QString addressBody(const QString& origAddress) {
+        QString address = origAddress.toLower();
+        if ( address.startsWith("0x") ) {
+            address.remove(0, 2);
+        }
+
+        return address.length() == 40 ? address : QString();
+    }
+
+    // EIP-55, a character is upper cased if its nibble of keccak(body) is over 7
+    static const QString applyChecksum(const QString& body, const QByteArray& hashed) {
+        QString result = "0x" + body;
+        for ( int i = 0; i < body.length(); i++ ) {
+            const uchar nibble = ((uchar)hashed.at(i / 2) >> (i % 2 == 0 ? 4 : 0)) & 0x0f;
+            if ( nibble > 7 ) {
+                result[i + 2] = body.at(i).toUpper();
+            }
+        }
+
+        return result;
+    }
+
     const QString Helpers::hexPrefix(const QString& val) {
         return val.indexOf("0x") == 0 ? val : ("0x" + val);
     }
@@ -27,117 +59,47 @@ namespace Dbixwall {
     }
 
     const QString Helpers::toDecStr(const QJsonValue& jv) {
-        std::string hexStr = jv.toString("0x0").remove(0, 2).toStdString();
-        const BigInt::Vin bv(hexStr, 16);
-        QString decStr = QString(bv.toStrDec().data());
-
-        return decStr;
+        return UInt256::fromHex(jv.toString("0x0")).toDec();
     }
 
     const QString Helpers::toDecStrDbix(const QJsonValue& jv) {
-        QString decStr = toDecStr(jv);
-
-        int dsl = decStr.length();
-        if ( dsl <= 18 ) {
-            decStr.prepend(QString(19 - dsl, '0'));
-            dsl = decStr.length();
-        }
-        decStr.insert(dsl - 18, '.');
-        return decStr;
+        return UInt256::fromHex(jv.toString("0x0")).toDec(18);
     }
 
     const QString Helpers::toDecStr(quint64 val) {
-        BigInt::Vin vinVal(val);
-        return QString(vinVal.toStrDec().data());
+        return QString::number(val);
     }
 
     const QString Helpers::toHexStr(quint64 val) {
-        BigInt::Vin vinVal(val);
-        return QString(vinVal.toStr0xHex().data());
+        return "0x" + QString::number(val, 16);
     }
 
-    const QString Helpers::toHexWeiStr(const QString& val) {
-        QString decStr = val;
-
-        int diff = 18;
-        int n = decStr.indexOf('.');
-        if ( n >= 0 ) {
-            decStr.replace(".", "");
-            diff = 18 - (decStr.length() - n);
-        }
-
-        for ( int i = 0; i < diff; i++ ) {
-            decStr.append('0');
+    const QString Helpers::toHexWeiStr(const QString& val, bool* ok) {
+        bool valid = false;
+        const UInt256 wei = UInt256::fromDecimal(val, 18, &valid);
+        if ( ok != 0 ) {
+            *ok = valid;
         }
 
-        BigInt::Vin vinVal(decStr.toUtf8().data(), 10);
-        QString res = QString(vinVal.toStr0xHex().data());
-
-        return res;
+        return valid ? wei.to0xHex() : QString();
     }
 
     const QString Helpers::toHexWeiStr(quint64 val) {
-        BigInt::Vin vinVal(val);
-        return QString(vinVal.toStr0xHex().data());
+        return "0x" + QString::number(val, 16);
     }
 
-    const QString Helpers::decStrToHexStr(const QString &dec) {
-        BigInt::Vin vinVal(dec.toStdString(), 10);
-        return QString(vinVal.toStr0xHex().data());
-    }
-
-    const QString Helpers::weiStrToDbixStr(const QString& wei) {
-        QString weiStr = wei;
-        while ( weiStr.length() < 18 ) {
-            weiStr.insert(0, '0');
+    const QString Helpers::decStrToHexStr(const QString &dec, bool* ok) {
+        bool valid = false;
+        const UInt256 value = UInt256::fromDec(dec, &valid);
+        if ( ok != 0 ) {
+            *ok = valid;
         }
 
-        weiStr.insert(weiStr.length() - 18, '.');
-        if ( weiStr.at(0) == '.' ) {
-            weiStr.insert(0, '0');
-        }
-        return weiStr;
-    }
-
-    BigInt::Rossi Helpers::decStrToRossi(const QString& dec) {
-        return BigInt::Rossi(dec.toStdString(), 10);
-    }
-
-    BigInt::Rossi Helpers::dbixStrToRossi(const QString& dec) {
-        QString decStr = dec;
-
-        int diff = 18;
-        int n = decStr.indexOf('.');
-        if ( n >= 0 ) {
-            decStr.replace(".", "");
-            diff = 18 - (decStr.length() - n);
-        }
-
-        for ( int i = 0; i < diff; i++ ) {
-            decStr.append('0');
-        }
-
-        return decStrToRossi(decStr);
+        return valid ? value.to0xHex() : QString();
     }
 
     const QString Helpers::formatDbixStr(const QString& dbix) {
-        QString decStr = dbix;
-
-        int n = decStr.indexOf('.');
-        int diff;
-        if ( n < 0 ) {
-            decStr.append('.');
-            n = decStr.indexOf('.');
-            diff = 18;
-        } else {
-            diff = 18 - (decStr.length() - n - 1);
-        }
-
-        for ( int i = 0; i < diff; i++ ) {
-            decStr.append('0');
-        }
-
-        return decStr;
+        return FixedDecimal::fromString(dbix).toString();
     }
 
     const QJsonArray Helpers::toQJsonArray(const AccountList& list) {
@@ -152,9 +114,7 @@ namespace Dbixwall {
     }
 
     quint64 Helpers::toQUInt64(const QJsonValue& jv) {
-        std::string hexStr = jv.toString("0x0").remove(0, 2).toStdString();
-        BigInt::Vin vin(hexStr, 16);
-        return vin.toUlong();
+        return UInt256::fromHex(jv.toString("0x0")).toUInt64();
     }
 
     int Helpers::parseAppVersion(const QString &ver) {
@@ -190,42 +150,80 @@ namespace Dbixwall {
     }
 
     const QString Helpers::vitalizeAddress(const QString& origAddress) {
-        QString address = origAddress.toLower();
-        if ( address.indexOf("0x") == 0 ) {
-            address = address.remove(0, 2);
+        const QString body = addressBody(origAddress);
+        if ( body.isEmpty() ) {
+            return origAddress;
         }
 
-        if ( address.length() != 40 ) {
-            return origAddress;
+        {
+            QMutexLocker locker(&sAddressCacheMutex);
+            const QString* cached = sAddressCache.object(body);
+            if ( cached != NULL ) {
+                return *cached;
+            }
         }
 
-        const QByteArray byteAddress = address.toUtf8();
-        u8* inData = (u8*) byteAddress.data();
-        u8 outData[32];
-        FIPS202_KECCAK_256(inData, byteAddress.size(), outData);
-        const QByteArray hashed = QByteArray((char*)outData, 32);
-        const QString hashStr = QString(hashed.toHex());
-
-        QString result = "";
-        int i = 0;
-        foreach ( const QChar c, address ) {
-            if ( c >= '0' && c <= '9' ) {
-                result += c;
-            } else {
-                bool ok = false;
-                int cVal = hashStr.mid(i, 1).toInt(&ok, 16);
-                if ( !ok ) {
-                    qDebug() << "error parsing int\n";
-                    return "0x0";
+        const QString result = applyChecksum(body, Dubaicoin::Keccak256::hash(body.toUtf8()));
+        QMutexLocker locker(&sAddressCacheMutex);
+        sAddressCache.insert(body, new QString(result));
+
+        return result;
+    }
+
+    const QStringList Helpers::vitalizeAddresses(const QStringList& origAddresses) {
+        QStringList result(origAddresses);
+        QList<int> pending; // result indexes that missed the cache
+        QList<int> pendingSlot; // their position in the hash batch
+        QHash<QString, int> positions; // body -> batch position, so duplicates hash once
+        QStringList bodies;
+        QList<QByteArray> batch;
+
+        {
+            QMutexLocker locker(&sAddressCacheMutex);
+            for ( int i = 0; i < origAddresses.size(); i++ ) {
+                const QString body = addressBody(origAddresses.at(i));
+                if ( body.isEmpty() ) {
+                    continue;
                 }
 
-                result += cVal > 7 ? c.toUpper() : c.toLower();
+                const QString* cached = sAddressCache.object(body);
+                if ( cached != NULL ) {
+                    result[i] = *cached;
+                    continue;
+                }
+
+                if ( !positions.contains(body) ) {
+                    positions.insert(body, bodies.size());
+                    bodies.append(body);
+                    batch.append(body.toUtf8());
+                }
+
+                pending.append(i);
+                pendingSlot.append(positions.value(body));
             }
+        }
+
+        if ( batch.isEmpty() ) {
+            return result;
+        }
 
-            i++;
+        const QList<QByteArray> hashes = Dubaicoin::Keccak256::hashMany(batch); // four lanes at a time
+        QStringList checksummed;
+        checksummed.reserve(bodies.size());
+        for ( int i = 0; i < bodies.size(); i++ ) {
+            checksummed.append(applyChecksum(bodies.at(i), hashes.at(i)));
         }
 
-        return "0x" + result;
+        for ( int i = 0; i < pending.size(); i++ ) {
+            result[pending.at(i)] = checksummed.at(pendingSlot.at(i));
+        }
+
+        QMutexLocker locker(&sAddressCacheMutex);
+        for ( int i = 0; i < bodies.size(); i++ ) {
+            sAddressCache.insert(bodies.at(i), new QString(checksummed.at(i)));
+        }
+
+        return result;
     }
 
     const QString Helpers::networkPostfix(int network)
@@ -250,6 +248,15 @@ namespace Dbixwall {
             }
         }
 
+        // history lives in the transaction store now, it goes out in the old settings format
+        // so importing puts it back through TransactionModel::migrateSettings
+        TransactionStore store;
+        if ( store.open(TransactionStore::defaultPath(), true) ) {
+            foreach ( const TransactionInfo& info, store.readAll() ) {
+                result += "transactions/" + info.getHash().toUtf8() + '\0' + info.toJsonString().toUtf8() + '\0';
+            }
+        }
+
         return result;
     }
 
@@ -3,10 +3,12 @@
 
 #include <QObject>
 #include <QString>
+#include <QStringList>
 #include <QJsonObject>
 #include <QNetworkReply>
 #include <QDir>
-#include "bigint.h"
+#include "uint256.h"
+#include "fixeddecimal.h"
 #include "types.h"
 
 namespace Dbixwall {
@@ -20,18 +22,16 @@ namespace Dbixwall {
         static const QString toDecStrDbix(const QJsonValue &jv);
         static const QString toDecStr(quint64 val);
         static const QString toHexStr(quint64 val);
-        static const QString toHexWeiStr(const QString& val);
+        static const QString toHexWeiStr(const QString& val, bool* ok = 0); // empty if val isn't a valid amount
         static const QString toHexWeiStr(quint64 val);
-        static const QString decStrToHexStr(const QString& dec);
-        static const QString weiStrToDbixStr(const QString& wei);
-        static BigInt::Rossi decStrToRossi(const QString& dec);
-        static BigInt::Rossi dbixStrToRossi(const QString& dec);
+        static const QString decStrToHexStr(const QString& dec, bool* ok = 0); // empty if dec isn't a valid number
         static const QString formatDbixStr(const QString& dbix);
         static const QJsonArray toQJsonArray(const AccountList& list);
         static quint64 toQUInt64(const QJsonValue& jv);
         static int parseAppVersion(const QString& ver);
         static QJsonObject parseHTTPReply(QNetworkReply *reply);
-        static const QString vitalizeAddress(const QString& origAddress);
+        static const QString vitalizeAddress(const QString& origAddress); // EIP-55 checksummed, cached
+        static const QStringList vitalizeAddresses(const QStringList& origAddresses); // same in one multi-lane batch
         static const QString networkPostfix(int network);
         static const QByteArray exportSettings();
         static void importSettings(const QByteArray& data);
@@ -0,0 +1,254 @@
+/*
+    This file is part of dbixwall.
+    dbixwall is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    dbixwall is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with dbixwall. If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file hexcodec.cpp
+ * @date 2026
+ *
+ * Vectorized hex encoding and decoding
+ */
+
+#include "hexcodec.h"
+
+#if defined(__GNUC__) && defined(__SSE2__) && ( defined(__x86_64__) || defined(__i386__) )
+#define HEXCODEC_X86
+#include <immintrin.h>
+#endif
+
+namespace Dbixwall {
+
+    typedef void (*EncodeKernel)(const uchar* in, int size, char* out);
+    typedef bool (*DecodeKernel)(const char* in, int size, uchar* out);
+
+    static const char sHexChars[] = "0123456789abcdef";
+
+    // nibble value per character, -1 for anything that isn't a hex digit
+    static const signed char sNibbles[256] = {
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1,
+        -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+    };
+
+    // *************************** Scalar **************************** //
+
+    static void encodeScalar(const uchar* in, int size, char* out) {
+        for ( int i = 0; i < size; i++ ) {
+            out[2 * i] = sHexChars[in[i] >> 4];
+            out[2 * i + 1] = sHexChars[in[i] & 0x0f];
+        }
+    }
+
+    static bool decodeScalar(const char* in, int size, uchar* out) {
+        for ( int i = 0; i < size; i += 2 ) {
+            const int hi = sNibbles[(uchar)in[i]];
+            const int lo = sNibbles[(uchar)in[i + 1]];
+            if ( ( hi | lo ) < 0 ) {
+                return false;
+            }
+            out[i / 2] = (uchar)( ( hi << 4 ) | lo );
+        }
+
+        return true;
+    }
+
+#ifdef HEXCODEC_X86
+    // ***************************** SSE2 ***************************** //
+
+    // nibbles (0..15 per byte) to their lowercase digits
+    static inline __m128i nibblesToHex128(__m128i nibbles) {
+        const __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10));
+        return _mm_add_epi8(nibbles, _mm_add_epi8(_mm_set1_epi8('0'), letters));
+    }
+
+    // digits to nibbles, valid gets 0xff for every byte that was a hex digit
+    static inline __m128i hexToNibbles128(__m128i chars, __m128i& valid) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+        const __m128i letter = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+        const __m128i isDigit = _mm_cmpeq_epi8(_mm_subs_epu8(digit, _mm_set1_epi8(9)), zero);
+        const __m128i isLetter = _mm_cmpeq_epi8(_mm_subs_epu8(letter, _mm_set1_epi8(5)), zero);
+        valid = _mm_or_si128(isDigit, isLetter);
+        return _mm_or_si128(_mm_and_si128(isDigit, digit), _mm_and_si128(isLetter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+    }
+
+    // 16 nibble pairs, high nibble in the low byte of each 16 bit lane, to one byte per lane
+    static inline __m128i joinNibbles128(__m128i nibbles) {
+        return _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00ff)), 4), _mm_srli_epi16(nibbles, 8));
+    }
+
+    static void encodeSSE2(const uchar* in, int size, char* out) {
+        const __m128i mask = _mm_set1_epi8(0x0f);
+        int i = 0;
+        for ( ; i + 16 <= size; i += 16 ) {
+            const __m128i bytes = _mm_loadu_si128((const __m128i*)(in + i));
+            const __m128i hi = nibblesToHex128(_mm_and_si128(_mm_srli_epi16(bytes, 4), mask));
+            const __m128i lo = nibblesToHex128(_mm_and_si128(bytes, mask));
+            _mm_storeu_si128((__m128i*)(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+            _mm_storeu_si128((__m128i*)(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+        }
+
+        encodeScalar(in + i, size - i, out + 2 * i);
+    }
+
+    static bool decodeSSE2(const char* in, int size, uchar* out) {
+        int i = 0;
+        for ( ; i + 32 <= size; i += 32 ) {
+            __m128i valid1;
+            __m128i valid2;
+            const __m128i n1 = hexToNibbles128(_mm_loadu_si128((const __m128i*)(in + i)), valid1);
+            const __m128i n2 = hexToNibbles128(_mm_loadu_si128((const __m128i*)(in + i + 16)), valid2);
+            if ( _mm_movemask_epi8(_mm_and_si128(valid1, valid2)) != 0xffff ) {
+                return false;
+            }
+            _mm_storeu_si128((__m128i*)(out + i / 2), _mm_packus_epi16(joinNibbles128(n1), joinNibbles128(n2)));
+        }
+
+        return decodeScalar(in + i, size - i, out + i / 2);
+    }
+
+    // ***************************** AVX2 ***************************** //
+
+    __attribute__((target("avx2")))
+    static inline __m256i nibblesToHex256(__m256i nibbles) {
+        const __m256i letters = _mm256_and_si256(_mm256_cmpgt_epi8(nibbles, _mm256_set1_epi8(9)), _mm256_set1_epi8('a' - '0' - 10));
+        return _mm256_add_epi8(nibbles, _mm256_add_epi8(_mm256_set1_epi8('0'), letters));
+    }
+
+    __attribute__((target("avx2")))
+    static inline __m256i hexToNibbles256(__m256i chars, __m256i& valid) {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+        const __m256i letter = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+        const __m256i isDigit = _mm256_cmpeq_epi8(_mm256_subs_epu8(digit, _mm256_set1_epi8(9)), zero);
+        const __m256i isLetter = _mm256_cmpeq_epi8(_mm256_subs_epu8(letter, _mm256_set1_epi8(5)), zero);
+        valid = _mm256_or_si256(isDigit, isLetter);
+        return _mm256_or_si256(_mm256_and_si256(isDigit, digit), _mm256_and_si256(isLetter, _mm256_add_epi8(letter, _mm256_set1_epi8(10))));
+    }
+
+    __attribute__((target("avx2")))
+    static inline __m256i joinNibbles256(__m256i nibbles) {
+        return _mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(nibbles, _mm256_set1_epi16(0x00ff)), 4), _mm256_srli_epi16(nibbles, 8));
+    }
+
+    __attribute__((target("avx2")))
+    static void encodeAVX2(const uchar* in, int size, char* out) {
+        const __m256i mask = _mm256_set1_epi8(0x0f);
+        int i = 0;
+        for ( ; i + 32 <= size; i += 32 ) {
+            const __m256i bytes = _mm256_loadu_si256((const __m256i*)(in + i));
+            const __m256i hi = nibblesToHex256(_mm256_and_si256(_mm256_srli_epi16(bytes, 4), mask));
+            const __m256i lo = nibblesToHex256(_mm256_and_si256(bytes, mask));
+            const __m256i first = _mm256_unpacklo_epi8(hi, lo); // bytes 0-7 and 16-23
+            const __m256i second = _mm256_unpackhi_epi8(hi, lo); // bytes 8-15 and 24-31
+            _mm256_storeu_si256((__m256i*)(out + 2 * i), _mm256_permute2x128_si256(first, second, 0x20));
+            _mm256_storeu_si256((__m256i*)(out + 2 * i + 32), _mm256_permute2x128_si256(first, second, 0x31));
+        }
+
+        encodeSSE2(in + i, size - i, out + 2 * i);
+    }
+
+    __attribute__((target("avx2")))
+    static bool decodeAVX2(const char* in, int size, uchar* out) {
+        int i = 0;
+        for ( ; i + 64 <= size; i += 64 ) {
+            __m256i valid1;
+            __m256i valid2;
+            const __m256i n1 = hexToNibbles256(_mm256_loadu_si256((const __m256i*)(in + i)), valid1);
+            const __m256i n2 = hexToNibbles256(_mm256_loadu_si256((const __m256i*)(in + i + 32)), valid2);
+            if ( _mm256_movemask_epi8(_mm256_and_si256(valid1, valid2)) != -1 ) {
+                return false;
+            }
+            const __m256i packed = _mm256_packus_epi16(joinNibbles256(n1), joinNibbles256(n2)); // per 128 bit lane
+            _mm256_storeu_si256((__m256i*)(out + i / 2), _mm256_permute4x64_epi64(packed, 0xd8));
+        }
+
+        return decodeSSE2(in + i, size - i, out + i / 2);
+    }
+
+    static bool hasAVX2() {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+    }
+
+    static const bool sUseAVX2 = hasAVX2();
+    static const EncodeKernel sEncode = sUseAVX2 ? encodeAVX2 : encodeSSE2;
+    static const DecodeKernel sDecode = sUseAVX2 ? decodeAVX2 : decodeSSE2;
+#else
+    static const bool sUseAVX2 = false;
+    static const EncodeKernel sEncode = encodeScalar;
+    static const DecodeKernel sDecode = decodeScalar;
+#endif
+
+    // *************************** HexCodec **************************** //
+
+    void HexCodec::encode(const uchar* in, int size, char* out) {
+        sEncode(in, size, out);
+    }
+
+    bool HexCodec::decode(const char* in, int size, uchar* out) {
+        return sDecode(in, size, out);
+    }
+
+    const QByteArray HexCodec::toHex(const QByteArray& bytes) {
+        QByteArray result(bytes.size() * 2, Qt::Uninitialized);
+        encode((const uchar*)bytes.constData(), bytes.size(), result.data());
+        return result;
+    }
+
+    const QByteArray HexCodec::fromHex(const QByteArray& hex) {
+        const int odd = hex.size() % 2; // a lone leading digit is its own byte, like QByteArray::fromHex
+        QByteArray result((hex.size() + odd) / 2, Qt::Uninitialized);
+        uchar* out = (uchar*)result.data();
+        const char* in = hex.constData();
+
+        if ( odd ) {
+            const int nibble = sNibbles[(uchar)in[0]];
+            if ( nibble < 0 ) {
+                return QByteArray::fromHex(hex);
+            }
+            *out++ = (uchar)nibble;
+            in++;
+        }
+
+        if ( !decode(in, hex.size() - odd, out) ) {
+            return QByteArray::fromHex(hex); // stray characters, let Qt skip them
+        }
+
+        return result;
+    }
+
+    const QByteArray HexCodec::fromHex(const QString& hex) {
+        return fromHex(hex.toLatin1());
+    }
+
+    const char* HexCodec::kernelName() {
+#ifdef HEXCODEC_X86
+        return sUseAVX2 ? "avx2" : "sse2";
+#else
+        return "scalar";
+#endif
+    }
+
+}
@@ -0,0 +1,45 @@
+/*
+    This file is part of dbixwall.
+    dbixwall is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    dbixwall is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with dbixwall. If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file hexcodec.h
+ * @date 2026
+ *
+ * Vectorized hex encoding and decoding header
+ */
+
+#ifndef HEXCODEC_H
+#define HEXCODEC_H
+
+#include <QByteArray>
+#include <QString>
+
+namespace Dbixwall {
+
+    // hex <-> bytes with SSE2/AVX2 kernels picked at runtime, scalar everywhere else
+    class HexCodec
+    {
+    public:
+        static void encode(const uchar* in, int size, char* out); // writes size * 2 lowercase digits
+        static bool decode(const char* in, int size, uchar* out); // size must be even, false on a non hex digit
+
+        // drop-in for QByteArray::toHex/fromHex, odd lengths and stray characters behave the same
+        static const QByteArray toHex(const QByteArray& bytes);
+        static const QByteArray fromHex(const QByteArray& hex);
+        static const QByteArray fromHex(const QString& hex);
+
+        static const char* kernelName(); // "avx2", "sse2" or "scalar"
+    };
+
+}
+
+#endif // HEXCODEC_H
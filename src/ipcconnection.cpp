@@ -0,0 +1,140 @@
+/*
+    This file is part of dbixwall.
+    dbixwall is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    dbixwall is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with dbixwall. If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file ipcconnection.cpp
+ * @date 2026
+ *
+ * Raw IPC connection
+ */
+
+#include "ipcconnection.h"
+
+namespace Dbixwall {
+
+// *************************** FrameReader **************************** //
+
+    FrameReader::FrameReader() : fBuffer(), fPos(0), fStart(0), fDepth(0), fInString(false), fEscaped(false)
+    {
+    }
+
+    void FrameReader::append(const QByteArray& data) {
+        fBuffer.append(data);
+    }
+
+    bool FrameReader::next(QByteArray& frame) {
+        const char* data = fBuffer.constData();
+        const int size = fBuffer.size();
+
+        while ( fPos < size ) {
+            const char c = data[fPos++];
+
+            if ( fInString ) {
+                if ( fEscaped ) {
+                    fEscaped = false;
+                } else if ( c == '\\' ) {
+                    fEscaped = true;
+                } else if ( c == '"' ) {
+                    fInString = false;
+                }
+                continue;
+            }
+
+            switch ( c ) {
+            case '"': fInString = ( fDepth > 0 ); break;
+            case '{':
+            case '[': {
+                    if ( fDepth++ == 0 ) {
+                        fStart = fPos - 1;
+                    }
+                    break;
+                }
+            case '}':
+            case ']': {
+                    if ( fDepth > 0 && --fDepth == 0 ) {
+                        frame = fBuffer.mid(fStart, fPos - fStart);
+                        fStart = fPos;
+                        return true;
+                    }
+                    break;
+                }
+            default: break; // values or whitespace between frames
+            }
+        }
+
+        // drop what's been handed out already, keep the unfinished frame
+        const int consumed = fDepth > 0 ? fStart : fPos;
+        if ( consumed > 0 ) {
+            fBuffer.remove(0, consumed);
+            fPos -= consumed;
+            fStart = 0;
+        }
+
+        return false;
+    }
+
+    void FrameReader::clear() {
+        fBuffer.clear();
+        fPos = 0;
+        fStart = 0;
+        fDepth = 0;
+        fInString = false;
+        fEscaped = false;
+    }
+
+// *************************** IPCConnection **************************** //
+
+    IPCConnection::IPCConnection(const QString& path, QObject* parent) :
+        QObject(parent), fPath(path), fSocket(this), fReader()
+    {
+        connect(&fSocket, (void (QLocalSocket::*)(QLocalSocket::LocalSocketError))&QLocalSocket::error, this, &IPCConnection::onError);
+        connect(&fSocket, &QLocalSocket::readyRead, this, &IPCConnection::onReadyRead);
+        connect(&fSocket, &QLocalSocket::connected, this, &IPCConnection::opened);
+    }
+
+    void IPCConnection::open() {
+        fReader.clear();
+        fSocket.connectToServer(fPath);
+    }
+
+    void IPCConnection::close() {
+        fSocket.abort();
+        fReader.clear();
+    }
+
+    bool IPCConnection::isOpen() const {
+        return fSocket.state() == QLocalSocket::ConnectedState;
+    }
+
+    bool IPCConnection::write(const QByteArray& data) {
+        if ( !fSocket.isWritable() || fSocket.write(data) <= 0 ) {
+            emit failed("Error on socket write: " + fSocket.errorString());
+            return false;
+        }
+
+        return true;
+    }
+
+    void IPCConnection::onReadyRead() {
+        fReader.append(fSocket.readAll());
+
+        QByteArray frame;
+        while ( fReader.next(frame) ) {
+            emit frameReceived(frame);
+        }
+    }
+
+    void IPCConnection::onError(QLocalSocket::LocalSocketError err __attribute__ ((unused))) {
+        emit failed(fSocket.errorString());
+    }
+
+}
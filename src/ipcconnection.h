@@ -0,0 +1,73 @@
+/*
+    This file is part of dbixwall.
+    dbixwall is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    dbixwall is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with dbixwall. If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file ipcconnection.h
+ * @date 2026
+ *
+ * Raw IPC connection header
+ */
+
+#ifndef IPCCONNECTION_H
+#define IPCCONNECTION_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QLocalSocket>
+
+namespace Dbixwall {
+
+    // splits the IPC byte stream into complete top level JSON values,
+    // nesting and string state is kept across reads so every byte is scanned once
+    class FrameReader {
+    public:
+        FrameReader();
+
+        void append(const QByteArray& data);
+        bool next(QByteArray& frame);
+        void clear();
+    private:
+        QByteArray fBuffer;
+        int fPos; // next byte to scan
+        int fStart; // start of the frame being scanned
+        int fDepth;
+        bool fInString;
+        bool fEscaped;
+    };
+
+    // one JSON-RPC connection to the node's IPC socket, hands out complete reply frames
+    class IPCConnection: public QObject
+    {
+        Q_OBJECT
+    public:
+        IPCConnection(const QString& path, QObject* parent = 0);
+
+        void open();
+        void close();
+        bool isOpen() const;
+        bool write(const QByteArray& data);
+    signals:
+        void opened() const;
+        void frameReceived(const QByteArray& frame) const;
+        void failed(const QString& error) const;
+    private slots:
+        void onReadyRead();
+        void onError(QLocalSocket::LocalSocketError err);
+    private:
+        QString fPath;
+        QLocalSocket fSocket;
+        FrameReader fReader;
+    };
+
+}
+
+#endif // IPCCONNECTION_H
@@ -81,7 +81,12 @@ int main(int argc, char *argv[])
     const QSslCertificate certificate(DbixWall_Cert.toUtf8());
     QSslSocket::addDefaultCaCertificate(certificate); */
 
+    // socket I/O, framing and reply decoding run off the GUI thread
+    QThread ipcThread;
     DbixIPC ipc(ipcPath, gdbixLog);
+    ipc.setWorker(&ipcThread);
+    ipcThread.start();
+
     CurrencyModel currencyModel;
     AccountModel accountModel(ipc, currencyModel);
     TransactionModel transactionModel(ipc, accountModel);
@@ -114,5 +119,10 @@ int main(int argc, char *argv[])
     }*/
 	ipc.init();
 
-    return app.exec();
+    const int result = app.exec();
+    ipc.shutdown();
+    ipcThread.quit();
+    ipcThread.wait();
+
+    return result;
 }
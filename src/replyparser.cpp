@@ -0,0 +1,628 @@
+/*
+    This file is part of dbixwall.
+    dbixwall is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    dbixwall is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with dbixwall. If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file replyparser.cpp
+ * @date 2026
+ *
+ * IPC reply parser
+ */
+
+#include "replyparser.h"
+#include "helpers.h"
+#include <QJsonValue>
+#include <cstring>
+
+namespace Dbixwall {
+
+    // ***************************** JsonSlice ***************************** //
+
+    JsonSlice::JsonSlice() : fData(NULL), fSize(0)
+    {
+    }
+
+    JsonSlice::JsonSlice(const char* data, int size) : fData(data), fSize(size)
+    {
+    }
+
+    bool JsonSlice::operator==(const char* literal) const {
+        const int len = (int)strlen(literal);
+        return len == fSize && memcmp(fData, literal, len) == 0;
+    }
+
+    const QString JsonSlice::toString() const {
+        return QString::fromLatin1(fData, fSize);
+    }
+
+    // ***************************** ReplyParser ***************************** //
+
+    ReplyParser::ReplyParser(const QByteArray& reply) :
+        fBegin(reply.constData()), fPos(reply.constData()), fEnd(reply.constData() + reply.size()), fFailed(false), fNullResult(false)
+    {
+    }
+
+    int ReplyParser::callID(const QByteArray& reply) {
+        ReplyParser parser(reply);
+        JsonSlice key;
+
+        if ( !parser.enter('{') ) {
+            return -1;
+        }
+
+        while ( parser.nextMember(key) ) {
+            if ( key == "id" ) {
+                parser.skipSpace();
+                int result = 0;
+                bool found = false;
+                while ( parser.fPos < parser.fEnd && *parser.fPos >= '0' && *parser.fPos <= '9' ) {
+                    result = result * 10 + (*parser.fPos++ - '0');
+                    found = true;
+                }
+
+                return found ? result : -1;
+            }
+
+            if ( !parser.skipValue() ) {
+                break;
+            }
+        }
+
+        return -1;
+    }
+
+    // subscription a notification (message without id) belongs to, empty if it's not one
+    const QString ReplyParser::subscriptionID(const QByteArray& reply) {
+        ReplyParser parser(reply);
+        if ( !parser.seekParams() ) {
+            return QString();
+        }
+
+        JsonSlice key;
+        while ( parser.nextMember(key) ) {
+            if ( key == "subscription" ) {
+                return parser.readText();
+            }
+
+            if ( !parser.skipValue() ) {
+                break;
+            }
+        }
+
+        return QString();
+    }
+
+    bool ReplyParser::isBatch(const QByteArray& frame) {
+        ReplyParser parser(frame);
+        return parser.peek('[');
+    }
+
+    bool ReplyParser::splitBatch(const QByteArray& frame, QList<QByteArray>& replies) {
+        ReplyParser parser(frame);
+        if ( !parser.enter('[') ) {
+            return false;
+        }
+
+        while ( parser.nextElement() ) {
+            const int start = parser.fPos - parser.fBegin;
+            if ( !parser.skipValue() ) {
+                return false;
+            }
+            replies.append(frame.mid(start, (parser.fPos - parser.fBegin) - start));
+        }
+
+        return !parser.fFailed;
+    }
+
+    bool ReplyParser::parseBlock(BlockInfo& block) {
+        if ( !seekResult() || !readBlock(block) ) {
+            return false;
+        }
+
+        vitalizeAddresses(block.fTransactions);
+        return true;
+    }
+
+    bool ReplyParser::parseTransaction(TransactionInfo& info) {
+        if ( !seekResult() || !readTransaction(info) ) {
+            return false;
+        }
+
+        info.fSender = Helpers::vitalizeAddress(info.fSender);
+        info.fReceiver = Helpers::vitalizeAddress(info.fReceiver);
+        return true;
+    }
+
+    bool ReplyParser::parseFilterChanges(QStringList& hashes, EventList& events) {
+        if ( !seekResult() ) {
+            return fNullResult; // gdbix returns null instead of [] if there were no changes, no result at all is an error reply
+        }
+
+        if ( !enter('[') ) {
+            return false;
+        }
+
+        while ( nextElement() ) {
+            if ( peek('"') ) { // block filter
+                hashes.append(readText());
+            } else {
+                EventInfo info;
+                if ( !readEvent(info) ) {
+                    return false;
+                }
+                events.append(info);
+            }
+        }
+
+        vitalizeAddresses(events);
+        return !fFailed;
+    }
+
+    bool ReplyParser::parseReceipt(QJsonObject& receipt) {
+        if ( !seekResult() || !enter('{') ) {
+            return false;
+        }
+
+        JsonSlice key;
+        while ( nextMember(key) ) {
+            if ( key == "logs" || key == "logsBloom" ) { // not used and the bulk of the receipt
+                skipValue();
+            } else if ( readNull() ) {
+                receipt.insert(key.toString(), QJsonValue(QJsonValue::Null));
+            } else if ( peek('"') ) {
+                receipt.insert(key.toString(), readText());
+            } else {
+                skipValue();
+            }
+        }
+
+        return !fFailed;
+    }
+
+    bool ReplyParser::parseHead(QString& hash) {
+        if ( !seekNotificationResult() || !enter('{') ) {
+            return false;
+        }
+
+        JsonSlice key;
+        while ( nextMember(key) ) {
+            if ( key == "hash" ) {
+                hash = readText();
+            } else {
+                skipValue();
+            }
+        }
+
+        return !fFailed && !hash.isEmpty();
+    }
+
+    bool ReplyParser::parseLog(EventInfo& info) {
+        if ( !seekNotificationResult() || !readEvent(info) ) {
+            return false;
+        }
+
+        info.fAddress = Helpers::vitalizeAddress(info.fAddress);
+        return true;
+    }
+
+    // checksums all the addresses of a block in one batch, see Helpers::vitalizeAddresses
+    void ReplyParser::vitalizeAddresses(TransactionList& list) {
+        QStringList addresses;
+        addresses.reserve(list.size() * 2);
+        foreach ( const TransactionInfo& info, list ) {
+            addresses.append(info.fSender);
+            addresses.append(info.fReceiver);
+        }
+
+        addresses = Helpers::vitalizeAddresses(addresses);
+        for ( int i = 0; i < list.size(); i++ ) {
+            TransactionInfo& info = list[i];
+            info.fSender = addresses.at(i * 2);
+            info.fReceiver = addresses.at(i * 2 + 1);
+        }
+    }
+
+    void ReplyParser::vitalizeAddresses(EventList& list) {
+        QStringList addresses;
+        addresses.reserve(list.size());
+        foreach ( const EventInfo& info, list ) {
+            addresses.append(info.fAddress);
+        }
+
+        addresses = Helpers::vitalizeAddresses(addresses);
+        for ( int i = 0; i < list.size(); i++ ) {
+            list[i].fAddress = addresses.at(i);
+        }
+    }
+
+    // positions inside the params object of a notification
+    bool ReplyParser::seekParams() {
+        fPos = fBegin;
+        fFailed = false;
+        if ( !enter('{') ) {
+            return false;
+        }
+
+        JsonSlice key;
+        while ( nextMember(key) ) {
+            if ( key == "params" ) {
+                return peek('{') && enter('{');
+            }
+
+            if ( !skipValue() ) {
+                return false;
+            }
+        }
+
+        return false;
+    }
+
+    bool ReplyParser::seekNotificationResult() {
+        if ( !seekParams() ) {
+            return false;
+        }
+
+        JsonSlice key;
+        while ( nextMember(key) ) {
+            if ( key == "result" ) {
+                return !readNull();
+            }
+
+            if ( !skipValue() ) {
+                return false;
+            }
+        }
+
+        return false;
+    }
+
+    bool ReplyParser::seekResult() {
+        fPos = fBegin;
+        fFailed = false;
+        fNullResult = false;
+        if ( !enter('{') ) {
+            return false;
+        }
+
+        JsonSlice key;
+        while ( nextMember(key) ) {
+            if ( key == "result" ) {
+                fNullResult = readNull();
+                return !fNullResult;
+            }
+
+            if ( !skipValue() ) {
+                return false;
+            }
+        }
+
+        return false;
+    }
+
+    bool ReplyParser::readBlock(BlockInfo& block) {
+        if ( !enter('{') ) {
+            return false;
+        }
+
+        JsonSlice key;
+        while ( nextMember(key) ) {
+            if ( key == "number" ) {
+                block.fNumber = readQuantity();
+            } else if ( key == "hash" ) {
+                block.fHash = readText();
+            } else if ( key == "miner" ) {
+                block.fMiner = readText();
+            } else if ( key == "transactions" ) {
+                if ( readNull() ) {
+                    continue;
+                }
+
+                if ( !enter('[') ) {
+                    return false;
+                }
+
+                while ( nextElement() ) {
+                    if ( peek('"') ) { // hashes only
+                        skipValue();
+                        continue;
+                    }
+
+                    TransactionInfo info;
+                    if ( !readTransaction(info) ) {
+                        return false;
+                    }
+                    block.fTransactions.append(info);
+                }
+            } else {
+                skipValue();
+            }
+        }
+
+        return !fFailed;
+    }
+
+    bool ReplyParser::readTransaction(TransactionInfo& info) {
+        if ( !enter('{') ) {
+            return false;
+        }
+
+        // same defaults as TransactionInfo::init(QJsonObject)
+        QString sender = "invalid";
+        QString receiver;
+        UInt256 value;
+        UInt256 gas;
+        UInt256 gasPrice;
+        info.fHash = "invalid";
+        info.fBlockHash = "invalid";
+        info.fInput = "invalid";
+        info.fNonce = 0;
+        info.fBlockNumber = 0;
+        info.fTransactionIndex = 0;
+
+        JsonSlice key;
+        while ( nextMember(key) ) {
+            if ( key == "hash" ) {
+                info.fHash = readText("invalid");
+            } else if ( key == "nonce" ) {
+                info.fNonce = readQuantity();
+            } else if ( key == "from" ) {
+                sender = readText("invalid");
+            } else if ( key == "to" ) {
+                receiver = readText();
+            } else if ( key == "blockHash" ) {
+                info.fBlockHash = readText("invalid");
+            } else if ( key == "blockNumber" ) {
+                info.fBlockNumber = readQuantity();
+            } else if ( key == "transactionIndex" ) {
+                info.fTransactionIndex = readQuantity();
+            } else if ( key == "value" ) {
+                value = readUInt256();
+            } else if ( key == "gas" ) {
+                gas = readUInt256();
+            } else if ( key == "gasPrice" ) {
+                gasPrice = readUInt256();
+            } else if ( key == "input" ) {
+                info.fInput = readText("invalid");
+            } else {
+                skipValue();
+            }
+        }
+
+        if ( fFailed ) {
+            return false;
+        }
+
+        // aliases are looked up by the consumer, only for transactions it keeps
+        // and the addresses are checksummed by the parse call, batched per block
+        info.fSender = sender;
+        info.fReceiver = receiver;
+        info.fValue = value.toDec(18);
+        info.fGas = gas.toDec();
+        info.fGasPrice = gasPrice.toDec(18);
+
+        return true;
+    }
+
+    bool ReplyParser::readEvent(EventInfo& info) {
+        if ( !enter('{') ) {
+            return false;
+        }
+
+        JsonSlice key;
+        while ( nextMember(key) ) {
+            if ( key == "blockNumber" ) {
+                info.fBlockNumber = readQuantity();
+            } else if ( key == "blockHash" ) {
+                info.fBlockHash = readText("invalid");
+            } else if ( key == "data" ) {
+                info.fData = readText();
+            } else if ( key == "address" ) {
+                info.fAddress = readText(); // checksummed by the parse call
+            } else if ( key == "transactionHash" ) {
+                info.fTransactionHash = readText();
+            } else if ( key == "topics" ) {
+                if ( readNull() ) {
+                    continue;
+                }
+
+                if ( !enter('[') ) {
+                    return false;
+                }
+
+                while ( nextElement() ) {
+                    info.fTopics.append(readText());
+                }
+            } else {
+                skipValue();
+            }
+        }
+
+        info.initMethodID();
+        return !fFailed;
+    }
+
+    void ReplyParser::skipSpace() {
+        while ( fPos < fEnd && ( *fPos == ' ' || *fPos == '\n' || *fPos == '\r' || *fPos == '\t' ) ) {
+            fPos++;
+        }
+    }
+
+    bool ReplyParser::fail() {
+        fFailed = true;
+        return false;
+    }
+
+    bool ReplyParser::peek(char c) {
+        skipSpace();
+        return fPos < fEnd && *fPos == c;
+    }
+
+    bool ReplyParser::enter(char open) {
+        if ( !peek(open) ) {
+            return fail();
+        }
+
+        fPos++;
+        return true;
+    }
+
+    bool ReplyParser::nextMember(JsonSlice& key) {
+        if ( fFailed ) {
+            return false;
+        }
+
+        if ( peek('}') ) {
+            fPos++;
+            return false;
+        }
+
+        if ( peek(',') ) {
+            fPos++;
+        }
+
+        if ( !readString(key) || !enter(':') ) {
+            return fail();
+        }
+
+        return true;
+    }
+
+    bool ReplyParser::nextElement() {
+        if ( fFailed ) {
+            return false;
+        }
+
+        if ( peek(']') ) {
+            fPos++;
+            return false;
+        }
+
+        if ( peek(',') ) {
+            fPos++;
+        }
+
+        skipSpace();
+        if ( fPos >= fEnd ) {
+            return fail();
+        }
+
+        return true;
+    }
+
+    bool ReplyParser::readNull() {
+        skipSpace();
+        if ( fEnd - fPos >= 4 && memcmp(fPos, "null", 4) == 0 ) {
+            fPos += 4;
+            return true;
+        }
+
+        return false;
+    }
+
+    bool ReplyParser::readString(JsonSlice& result) {
+        if ( !enter('"') ) {
+            return false;
+        }
+
+        const char* start = fPos;
+        while ( fPos < fEnd && *fPos != '"' ) {
+            if ( *fPos == '\\' ) {
+                fPos++;
+            }
+            fPos++;
+        }
+
+        if ( fPos >= fEnd ) {
+            return fail();
+        }
+
+        result = JsonSlice(start, fPos - start);
+        fPos++; // closing quote
+        return true;
+    }
+
+    bool ReplyParser::skipValue() {
+        skipSpace();
+        if ( fPos >= fEnd ) {
+            return fail();
+        }
+
+        if ( *fPos == '"' ) {
+            JsonSlice dummy;
+            return readString(dummy);
+        }
+
+        if ( *fPos == '{' || *fPos == '[' ) {
+            int depth = 0;
+            bool inString = false;
+            while ( fPos < fEnd ) {
+                const char c = *fPos++;
+                if ( inString ) {
+                    if ( c == '\\' ) {
+                        fPos++;
+                    } else if ( c == '"' ) {
+                        inString = false;
+                    }
+                } else if ( c == '"' ) {
+                    inString = true;
+                } else if ( c == '{' || c == '[' ) {
+                    depth++;
+                } else if ( c == '}' || c == ']' ) {
+                    if ( --depth == 0 ) {
+                        return true;
+                    }
+                }
+            }
+
+            return fail();
+        }
+
+        // number, bool or null
+        while ( fPos < fEnd && *fPos != ',' && *fPos != '}' && *fPos != ']' &&
+                *fPos != ' ' && *fPos != '\n' && *fPos != '\r' && *fPos != '\t' ) {
+            fPos++;
+        }
+
+        return true;
+    }
+
+    const QString ReplyParser::readText(const QString& defaultValue) {
+        if ( readNull() ) {
+            return defaultValue;
+        }
+
+        JsonSlice slice;
+        if ( !readString(slice) ) {
+            return defaultValue;
+        }
+
+        return slice.toString();
+    }
+
+    quint64 ReplyParser::readQuantity() {
+        return readUInt256().toUInt64();
+    }
+
+    // hex quantity straight from the buffer, null and malformed values read as zero
+    const UInt256 ReplyParser::readUInt256() {
+        if ( readNull() ) {
+            return UInt256();
+        }
+
+        JsonSlice slice;
+        if ( !readString(slice) ) {
+            return UInt256();
+        }
+
+        return UInt256::fromHex(slice.fData, slice.fSize);
+    }
+
+}
@@ -0,0 +1,97 @@
+/*
+    This file is part of dbixwall.
+    dbixwall is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    dbixwall is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with dbixwall. If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file replyparser.h
+ * @date 2026
+ *
+ * IPC reply parser header
+ */
+
+#ifndef REPLYPARSER_H
+#define REPLYPARSER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QJsonObject>
+#include "types.h"
+#include "contractinfo.h"
+#include "uint256.h"
+
+namespace Dbixwall {
+
+    // raw view into the reply buffer, only valid while the buffer lives
+    class JsonSlice
+    {
+    public:
+        JsonSlice();
+        JsonSlice(const char* data, int size);
+
+        bool operator==(const char* literal) const;
+        const QString toString() const;
+        const char* fData;
+        int fSize;
+    };
+
+    // pull style JSON reader decoding IPC replies straight into our types
+    // without building a QJsonDocument. Strings are taken as-is without
+    // unescaping since we only decode hex data and addresses this way.
+    class ReplyParser
+    {
+    public:
+        ReplyParser(const QByteArray& reply);
+
+        static int callID(const QByteArray& reply);
+        static const QString subscriptionID(const QByteArray& reply);
+        static bool isBatch(const QByteArray& frame);
+        static bool splitBatch(const QByteArray& frame, QList<QByteArray>& replies);
+
+        bool parseBlock(BlockInfo& block);
+        bool parseTransaction(TransactionInfo& info);
+        bool parseFilterChanges(QStringList& hashes, EventList& events);
+        bool parseReceipt(QJsonObject& receipt);
+        bool parseHead(QString& hash);
+        bool parseLog(EventInfo& info);
+    private:
+        const char* fBegin;
+        const char* fPos;
+        const char* fEnd;
+        bool fFailed;
+        bool fNullResult; // last seekResult found "result": null
+
+        bool seekResult();
+        bool seekParams();
+        bool seekNotificationResult();
+        bool readBlock(BlockInfo& block);
+        bool readTransaction(TransactionInfo& info);
+        bool readEvent(EventInfo& info);
+        static void vitalizeAddresses(TransactionList& list);
+        static void vitalizeAddresses(EventList& list);
+
+        void skipSpace();
+        bool fail();
+        bool peek(char c);
+        bool enter(char open);
+        bool nextMember(JsonSlice& key);
+        bool nextElement();
+        bool readNull();
+        bool readString(JsonSlice& result);
+        bool skipValue();
+        const QString readText(const QString& defaultValue = QString());
+        quint64 readQuantity();
+        const UInt256 readUInt256();
+    };
+
+}
+
+#endif // REPLYPARSER_H
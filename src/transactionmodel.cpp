@@ -28,11 +28,14 @@
 #include <QJsonDocument>
 #include <QCoreApplication>
 #include <QSettings>
+#include <QDir>
+#include <QFileInfo>
+#include <QSet>
 
 namespace Dbixwall {
 
     TransactionModel::TransactionModel(DbixIPC& ipc, const AccountModel& accountModel) :
-        QAbstractListModel(0), fIpc(ipc), fAccountModel(accountModel), fBlockNumber(0), fLastBlock(0), fFirstBlock(0), fGasPrice("unknown"), fGasEstimate("unknown"), fNetManager(this),
+        QAbstractListModel(0), fIpc(ipc), fAccountModel(accountModel), fRowBase(0), fBlockNumber(0), fLastBlock(0), fFirstBlock(0), fGasPrice("unknown"), fGasEstimate("unknown"), fNetManager(this),
         fLatestVersion(QCoreApplication::applicationVersion())
     {
         connect(&ipc, &DbixIPC::connectToServerDone, this, &TransactionModel::connectToServerDone);
@@ -45,6 +48,11 @@ namespace Dbixwall {
         connect(&ipc, &DbixIPC::newBlock, this, &TransactionModel::newBlock);
 
         connect(&fNetManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(httpRequestDone(QNetworkReply*)));
+
+        const QString storePath = TransactionStore::defaultPath();
+        QDir().mkpath(QFileInfo(storePath).absolutePath());
+        fStore.open(storePath); // logs why if it fails, history is then refetched every run
+
         checkVersion(); // TODO: move this off at some point
     }
 
@@ -94,7 +102,7 @@ namespace Dbixwall {
     }
 
     int TransactionModel::rowCount(const QModelIndex & parent __attribute__ ((unused))) const {
-        return fTransactionList.size();
+        return fTransactions.size();
     }
 
     QVariant TransactionModel::data(const QModelIndex & index, int role) const {
@@ -102,7 +110,7 @@ namespace Dbixwall {
 
         // calculate distance from current block
         if ( role == DepthRole ) {
-            quint64 transBlockNum = fTransactionList.at(row).value(BlockNumberRole).toULongLong();
+            const quint64 transBlockNum = fTransactions.blockNumber(row);
             if ( transBlockNum == 0 ) { // still pending
                 return -1;
             }
@@ -111,19 +119,12 @@ namespace Dbixwall {
             return diff;
         }
 
-        return fTransactionList.at(row).value(role);
+        return fTransactions.value(row, role);
     }
 
     int TransactionModel::containsTransaction(const QString& hash) {
-        int i = 0;
-        foreach ( const TransactionInfo& t, fTransactionList ) {
-            if ( t.value(THashRole).toString() == hash ) {
-                return i;
-            }
-            i++;
-        }
-
-        return -1;
+        const QHash<QString, int>::const_iterator it = fTransactionRows.constFind(hash);
+        return it == fTransactionRows.constEnd() ? -1 : it.value() + fRowBase;
     }
 
     void TransactionModel::connectToServerDone() {
@@ -148,9 +149,9 @@ namespace Dbixwall {
 
         emit blockNumberChanged(num);
 
-        if ( !fTransactionList.isEmpty() ) { // depth changed for all
+        if ( fTransactions.size() > 0 ) { // depth changed for all
             const QModelIndex& leftIndex = QAbstractListModel::createIndex(0, 5);
-            const QModelIndex& rightIndex = QAbstractListModel::createIndex(fTransactionList.length() - 1, 5);
+            const QModelIndex& rightIndex = QAbstractListModel::createIndex(fTransactions.size() - 1, 5);
             emit dataChanged(leftIndex, rightIndex, QVector<int>(1, DepthRole));
         }
     }
@@ -181,25 +182,24 @@ namespace Dbixwall {
 
     void TransactionModel::newTransaction(const TransactionInfo &info) {
         int ai1, ai2;
-        const QString& sender = info.value(SenderRole).toString().toLower();
-        const QString& receiver = info.value(ReceiverRole).toString().toLower();
+        const QString& sender = info.value(SenderRole).toString();
+        const QString& receiver = info.value(ReceiverRole).toString();
         if ( fAccountModel.containsAccount(sender, receiver, ai1, ai2) ) { // either our sent or someone sent to us
             const int n = containsTransaction(info.value(THashRole).toString());
             if ( n >= 0 ) { // ours
-                fTransactionList[n] = info;
-                const QModelIndex& leftIndex = QAbstractListModel::createIndex(n, 0);
-                const QModelIndex& rightIndex = QAbstractListModel::createIndex(n, 14);
+                const int row = updateTransaction(n, info);
+                const QModelIndex& leftIndex = QAbstractListModel::createIndex(row, 0);
+                const QModelIndex& rightIndex = QAbstractListModel::createIndex(row, 14);
                 emit dataChanged(leftIndex, rightIndex);
-                storeTransaction(fTransactionList.at(n));
+                storeTransaction(info);
             } else { // external from someone to us
                 addTransaction(info);
             }
         }
     }
 
-    void TransactionModel::newBlock(const QJsonObject& block) {
-        const QJsonArray transactions = block.value("transactions").toArray();
-        const quint64 blockNum = Helpers::toQUInt64(block.value("number"));
+    void TransactionModel::newBlock(const BlockInfo& block) {
+        const quint64 blockNum = block.number();
 
         if ( blockNum == 0 ) {
             return; // not interested in pending blocks
@@ -207,181 +207,317 @@ namespace Dbixwall {
 
         fIpc.getGasPrice(); // let's update our gas price
 
-        foreach ( QJsonValue t, transactions ) {
-            const QJsonObject to = t.toObject();
-            const QString thash = to.value("hash").toString();
-            const QString sender = to.value("from").toString().toLower();
-            const QString receiver = to.value("to").toString().toLower();
+        foreach ( const TransactionInfo& t, block.transactions() ) {
+            const QString thash = t.getHash();
+            const QString sender = t.value(SenderRole).toString();
+            const QString receiver = t.value(ReceiverRole).toString();
             int i1, i2;
 
             const int n = containsTransaction(thash);
             if ( n >= 0 ) {
-                fTransactionList[n].init(to);
-                const QModelIndex& leftIndex = QAbstractListModel::createIndex(n, 0);
-                const QModelIndex& rightIndex = QAbstractListModel::createIndex(n, 14);
+                TransactionInfo info(t);
+                info.lookupAccountAliases();
+                const int row = updateTransaction(n, info);
+                const QModelIndex& leftIndex = QAbstractListModel::createIndex(row, 0);
+                const QModelIndex& rightIndex = QAbstractListModel::createIndex(row, 14);
                 QVector<int> roles(2);
                 roles[0] = BlockNumberRole;
                 roles[1] = DepthRole;
                 emit dataChanged(leftIndex, rightIndex, roles);
-                const TransactionInfo info = fTransactionList.at(n);
-                storeTransaction(fTransactionList.at(n));
+                storeTransaction(info);
                 emit confirmedTransaction(info.value(ReceiverRole).toString(), info.value(THashRole).toString());
             } else if ( fAccountModel.containsAccount(sender, receiver, i1, i2) ) {
-                const TransactionInfo info = TransactionInfo(to);
+                TransactionInfo info(t);
+                info.lookupAccountAliases();
                 addTransaction(info);
                 emit receivedTransaction(info.value(ReceiverRole).toString());
             }
         }
     }
 
-    int TransactionModel::getInsertIndex(const TransactionInfo& info) const {
-        const quint64 block = info.value(BlockNumberRole).toULongLong();
+    // row order: pending transactions (block 0) on top, then the newest block first
+    static bool rowBefore(quint64 aBlock, quint64 aIndex, quint64 bBlock, quint64 bIndex) {
+        if ( aBlock == 0 ) {
+            aBlock = Q_UINT64_C(0xffffffffffffffff);
+        }
+        if ( bBlock == 0 ) {
+            bBlock = Q_UINT64_C(0xffffffffffffffff);
+        }
 
-        if ( block == 0 ) {
+        if ( aBlock != bBlock ) {
+            return aBlock > bBlock;
+        }
+
+        return aIndex > bIndex;
+    }
+
+    static bool transCompare(const TransactionInfo& a, const TransactionInfo& b) {
+        return rowBefore(a.getBlockNumber(), a.getTransactionIndex(), b.getBlockNumber(), b.getTransactionIndex());
+    }
+
+    int TransactionModel::getInsertIndex(const TransactionInfo& info) const {
+        if ( info.getBlockNumber() == 0 ) {
             return 0; // new/pending
         }
 
-        for ( int i = 0; i < fTransactionList.length(); i++ ) {
-            const quint64 oldBlock = fTransactionList.at(i).value(BlockNumberRole).toULongLong();
-            if ( oldBlock <= block ) {
-                return i;
+        // first row that doesn't go before info, so it lands on top of its block
+        int low = 0;
+        int high = fTransactions.size();
+        while ( low < high ) {
+            const int mid = (low + high) / 2;
+            if ( rowBefore(fTransactions.blockNumber(mid), fTransactions.transactionIndex(mid), info.getBlockNumber(), info.getTransactionIndex()) ) {
+                low = mid + 1;
+            } else {
+                high = mid;
             }
         }
 
-        return fTransactionList.length();
+        return low;
     }
 
     void TransactionModel::addTransaction(const TransactionInfo& info) {
         const int index = getInsertIndex(info);
         beginInsertRows(QModelIndex(), index, index);
-        fTransactionList.insert(index, info);
+        fTransactions.insert(index, info);
+        indexRow(index, info.getHash());
         endInsertRows();
 
         storeTransaction(info);
     }
 
+    // replaces the row in place, or moves it if the new block or index puts it elsewhere
+    // in the order (pending got mined, reorg), returns the row it ended up in
+    int TransactionModel::updateTransaction(int row, const TransactionInfo& info) {
+        const int dest = getInsertIndex(info); // the rest is still sorted, only this row may be off now
+        if ( dest == row || dest == row + 1 ) {
+            fTransactions.replace(row, info);
+            return row;
+        }
+
+        const int index = dest > row ? dest - 1 : dest;
+        beginMoveRows(QModelIndex(), row, row, QModelIndex(), dest);
+        const QString hash = fTransactions.hash(row);
+        fTransactions.remove(row);
+        unindexRow(row, hash);
+        fTransactions.insert(index, info);
+        indexRow(index, info.getHash());
+        endMoveRows();
+
+        return index;
+    }
+
+    // after inserting into fTransactions, only the keys on the shorter side get touched,
+    // new transactions mostly go on top
+    void TransactionModel::indexRow(int row, const QString& hash) {
+        if ( row < fTransactions.size() / 2 ) {
+            shiftKeys(0, row, 0, -1); // rows above stay where they are while the base moves
+            fRowBase++;
+        } else {
+            shiftKeys(row + 1, fTransactions.size(), 1, 1); // rows below moved down by one
+        }
+
+        const int existing = containsTransaction(hash);
+        if ( existing < 0 || existing > row ) { // duplicates resolve to the first row
+            fTransactionRows.insert(hash, row - fRowBase);
+        }
+    }
+
+    // after removing from fTransactions, same as above the other way around
+    void TransactionModel::unindexRow(int row, const QString& hash) {
+        if ( containsTransaction(hash) == row ) {
+            fTransactionRows.remove(hash);
+        }
+
+        if ( row < fTransactions.size() / 2 ) {
+            shiftKeys(0, row, 0, 1);
+            fRowBase--;
+        } else {
+            shiftKeys(row, fTransactions.size(), -1, -1); // rows below moved up by one
+        }
+    }
+
     void TransactionModel::storeTransaction(const TransactionInfo& info) {
         // save to persistent memory for re-run
-        const quint64 blockNum = info.value(BlockNumberRole).toULongLong();
-        QSettings settings;
-        settings.beginGroup("transactions");
-        settings.setValue(Helpers::toDecStr(blockNum) + "_" + info.value(TransactionIndexRole).toString(), info.toJsonString());
-        settings.endGroup();
+        if ( fStore.append(info) && fLegacyKeys.contains(info.getHash().toLower()) ) { // old format entry finally got its full data
+            QSettings settings;
+            settings.beginGroup("transactions");
+            settings.remove(fLegacyKeys.take(info.getHash().toLower()));
+            settings.endGroup();
+        }
     }
 
-    bool transCompare(const TransactionInfo& a, const TransactionInfo& b) {
-        return a.getBlockNumber() > b.getBlockNumber();
-    }
+    // moves transactions stored by older versions in the "transactions" settings group
+    // over to the store, settings from an imported backup come through here too.
+    // A key is only removed once its transaction made it to the store, so anything
+    // that fails stays in settings and gets another go on the next refresh
+    void TransactionModel::migrateSettings() {
+        if ( !fStore.isOpen() ) {
+            return; // keep them where they are
+        }
 
-    void TransactionModel::refresh() {
         QSettings settings;
         settings.beginGroup("transactions");
-        QStringList list = settings.allKeys();
+        const QStringList list = settings.allKeys();
+        if ( list.isEmpty() ) {
+            return;
+        }
 
+        int migrated = 0;
+        int kept = 0;
         foreach ( const QString bns, list ) {
             const QString val = settings.value(bns, "bogus").toString();
-            if ( val.contains("{") ) { // new format, get data and reload only recent transactions
+            if ( val.contains("{") ) { // new format, full data
                 QJsonParseError parseError;
                 const QJsonDocument jsonDoc = QJsonDocument::fromJson(val.toUtf8(), &parseError);
 
                 if ( parseError.error != QJsonParseError::NoError ) {
                     DbixLog::logMsg("Error parsing stored transaction: " + parseError.errorString(), LS_Error);
+                    kept++;
+                } else if ( fStore.append(TransactionInfo(jsonDoc.object())) ) {
+                    settings.remove(bns);
+                    migrated++;
                 } else {
-                    const TransactionInfo info(jsonDoc.object());
-                    newTransaction(info);
-                    // if transaction is newer than 1 day restore it from gdbix anyhow to ensure correctness in case of reorg
-                    if ( info.getBlockNumber() == 0 || fBlockNumber - info.getBlockNumber() < 5400 ) {
-                        fIpc.getTransactionByHash(info.getHash());
-                    }
+                    kept++;
                 }
-            } else if ( val != "bogus" ) { // old format, re-get and store full data
+            } else if ( val != "bogus" ) { // old format, re-get and store full data, storeTransaction removes the key then
+                fLegacyKeys.insert(val.toLower(), bns);
                 fIpc.getTransactionByHash(val);
-                settings.remove(bns);
+                kept++;
             }
         }
         settings.endGroup();
 
-        qSort(fTransactionList.begin(), fTransactionList.end(), transCompare);
+        DbixLog::logMsg("Moved " + QString::number(migrated) + " stored transactions from settings to the transaction store, " +
+                        QString::number(kept) + " left in settings for now", LS_Info);
     }
 
-    const QString TransactionModel::estimateTotal(const QString& value, const QString& gas) const {
-        BigInt::Rossi valRossi = Helpers::dbixStrToRossi(value);
-        BigInt::Rossi valGas = Helpers::decStrToRossi(gas);
-        BigInt::Rossi valGasPrice = Helpers::dbixStrToRossi(fGasPrice);
+    // bulk load, builds the sorted list once and resets the model instead of inserting row by row
+    void TransactionModel::refresh() {
+        migrateSettings();
+
+        TransactionList list;
+        QSet<QString> loaded;
+        foreach ( TransactionInfo info, fStore.readAll() ) {
+            int i1, i2;
+            if ( !fAccountModel.containsAccount(info.value(SenderRole).toString(), info.value(ReceiverRole).toString(), i1, i2) ) {
+                continue;
+            }
+
+            info.lookupAccountAliases();
+            list.append(info);
+            loaded.insert(info.getHash());
+            // if transaction is newer than 1 day restore it from gdbix anyhow to ensure correctness in case of reorg
+            if ( info.getBlockNumber() == 0 || fBlockNumber - info.getBlockNumber() < 5400 ) {
+                fIpc.getTransactionByHash(info.getHash());
+            }
+        }
+
+        for ( int i = 0; i < fTransactions.size(); i++ ) { // keep what the store doesn't have, e.g. if it failed to open
+            if ( !loaded.contains(fTransactions.hash(i)) ) {
+                list.append(fTransactions.at(i));
+            }
+        }
+
+        qStableSort(list.begin(), list.end(), transCompare);
+
+        beginResetModel();
+        fTransactions.assign(list);
+        indexTransactions();
+        endResetModel();
+    }
+
+    // adds delta to the keys of rows [first, last), which moved by moved rows. Duplicates further down
+    // are left alone, walking against delta keeps an adjusted key from matching a later row
+    void TransactionModel::shiftKeys(int first, int last, int moved, int delta) {
+        const int step = delta > 0 ? -1 : 1;
+        for ( int row = delta > 0 ? last - 1 : first; row >= first && row < last; row += step ) {
+            const QHash<QString, int>::iterator it = fTransactionRows.find(fTransactions.hash(row));
+            if ( it != fTransactionRows.end() && it.value() + fRowBase == row - moved ) {
+                it.value() += delta;
+            }
+        }
+    }
+
+    void TransactionModel::indexTransactions() {
+        fRowBase = 0;
+        fTransactionRows.clear();
+        fTransactionRows.reserve(fTransactions.size());
+        for ( int i = fTransactions.size() - 1; i >= 0; i-- ) { // duplicates resolve to the first row
+            fTransactionRows.insert(fTransactions.hash(i), i);
+        }
+    }
 
-        const QString wei = QString((valRossi + valGas * valGasPrice).toStrDec().data());
+    const QString TransactionModel::estimateTotal(const QString& value, const QString& gas) const {
+        const UInt256 gasWei = UInt256::fromDec(gas) * FixedDecimal::fromString(fGasPrice).raw();
 
-        return Helpers::weiStrToDbixStr(wei);
+        return (FixedDecimal::fromString(value) + FixedDecimal::fromRaw(gasWei)).toString();
     }
 
     const QString TransactionModel::getHash(int index) const {
-        if ( index >= 0 && index < fTransactionList.length() ) {
-            return fTransactionList.at(index).value(THashRole).toString();
+        if ( index >= 0 && index < fTransactions.size() ) {
+            return fTransactions.value(index, THashRole).toString();
         }
 
         return QString();
     }
 
     const QString TransactionModel::getSender(int index) const {
-        if ( index >= 0 && index < fTransactionList.length() ) {
-            return fTransactionList.at(index).value(SenderRole).toString();
+        if ( index >= 0 && index < fTransactions.size() ) {
+            return fTransactions.value(index, SenderRole).toString();
         }
 
         return QString();
     }
 
     const QString TransactionModel::getReceiver(int index) const {
-        if ( index >= 0 && index < fTransactionList.length() ) {
-            return fTransactionList.at(index).value(ReceiverRole).toString();
+        if ( index >= 0 && index < fTransactions.size() ) {
+            return fTransactions.value(index, ReceiverRole).toString();
         }
 
         return QString();
     }
 
     double TransactionModel::getValue(int index) const {
-        if ( index >= 0 && index < fTransactionList.length() ) {
-            return fTransactionList.at(index).value(ValueRole).toFloat();
+        if ( index >= 0 && index < fTransactions.size() ) {
+            return fTransactions.value(index, ValueRole).toFloat();
         }
 
         return 0;
     }
 
     const QJsonObject TransactionModel::getJson(int index, bool decimal) const {
-        if ( index < 0 || index >= fTransactionList.length() ) {
+        if ( index < 0 || index >= fTransactions.size() ) {
             return QJsonObject();
         }
 
-        return fTransactionList.at(index).toJson(decimal);
+        return fTransactions.at(index).toJson(decimal);
     }
 
     const QString TransactionModel::getMaxValue(int row, const QString& gas, const QString& gasPrice) const {
         const QModelIndex index = QAbstractListModel::createIndex(row, 2);
 
-        BigInt::Rossi balanceWeiRossi = Helpers::dbixStrToRossi( fAccountModel.data(index, BalanceRole).toString() );
-        const BigInt::Rossi gasRossi = Helpers::decStrToRossi(gas);
-        const BigInt::Rossi gasPriceRossi = Helpers::dbixStrToRossi(gasPrice);
-        const BigInt::Rossi gasTotalRossi = gasRossi * gasPriceRossi;
+        const FixedDecimal balance = FixedDecimal::fromString( fAccountModel.data(index, BalanceRole).toString() );
+        const FixedDecimal gasTotal = FixedDecimal::fromRaw(UInt256::fromDec(gas) * FixedDecimal::fromString(gasPrice).raw());
 
-        if ( balanceWeiRossi < gasTotalRossi ) {
+        if ( balance < gasTotal ) {
             return "0";
         }
-        const BigInt::Rossi resultWeiRossi = (balanceWeiRossi - gasTotalRossi);
-
-        const QString resultWei = QString(resultWeiRossi.toStrDec().data());
 
-        return Helpers::weiStrToDbixStr(resultWei);
+        return (balance - gasTotal).toString();
     }
 
     void TransactionModel::lookupAccountsAliases() {
-        for ( int n = 0; n < fTransactionList.size(); n++ ) {
-            fTransactionList[n].lookupAccountAliases();
+        for ( int n = 0; n < fTransactions.size(); n++ ) {
+            TransactionInfo info = fTransactions.at(n);
+            info.lookupAccountAliases();
+            fTransactions.replace(n, info);
         }
 
         QVector<int> roles(2);
         roles[0] = SenderRole;
         roles[1] = ReceiverRole;
         const QModelIndex& leftIndex = QAbstractListModel::createIndex(0, 0);
-        const QModelIndex& rightIndex = QAbstractListModel::createIndex(fTransactionList.size(), 0);
+        const QModelIndex& rightIndex = QAbstractListModel::createIndex(fTransactions.size(), 0);
 
         emit dataChanged(leftIndex, rightIndex, roles);
     }
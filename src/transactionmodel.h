@@ -30,6 +30,8 @@
 #include "types.h"
 #include "dbixipc.h"
 #include "accountmodel.h"
+#include "transactionstore.h"
+#include "transactiontable.h"
 #include "dbixlog.h"
 
 namespace Dbixwall {
@@ -77,7 +79,7 @@ namespace Dbixwall {
                              const QString& value, const QString& gas = QString(),
                              const QString& gasPrice = QString(), const QString& data = QString());
         void newTransaction(const TransactionInfo& info);
-        void newBlock(const QJsonObject& block);
+        void newBlock(const BlockInfo& block);
         void refresh();
         void loadHistoryDone(QNetworkReply* reply);
         void checkVersionDone(QNetworkReply *reply);
@@ -94,7 +96,9 @@ namespace Dbixwall {
     private:
         DbixIPC& fIpc;
         const AccountModel& fAccountModel;
-        TransactionList fTransactionList;
+        TransactionTable fTransactions;
+        QHash<QString, int> fTransactionRows; // hash -> row in fTransactions minus fRowBase
+        int fRowBase; // moves instead of every key when rows get inserted on top
         quint64 fBlockNumber;
         quint64 fLastBlock;
         quint64 fFirstBlock;
@@ -103,10 +107,18 @@ namespace Dbixwall {
         TransactionInfo fQueuedTransaction;
         QNetworkAccessManager fNetManager;
         QString fLatestVersion;
+        TransactionStore fStore;
+        QHash<QString, QString> fLegacyKeys; // hash -> old format settings key awaiting its full data
 
         int getInsertIndex(const TransactionInfo& info) const;
         void addTransaction(const TransactionInfo& info);
+        int updateTransaction(int row, const TransactionInfo& info);
+        void indexTransactions();
+        void indexRow(int row, const QString& hash);
+        void unindexRow(int row, const QString& hash);
+        void shiftKeys(int first, int last, int moved, int delta);
         void storeTransaction(const TransactionInfo& info);
+        void migrateSettings();
     };
 
 }
@@ -0,0 +1,449 @@
+/*
+    This file is part of dbixwall.
+    dbixwall is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    dbixwall is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with dbixwall. If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file transactionstore.cpp
+ * @date 2026
+ *
+ * Append only transaction log
+ */
+
+#include "transactionstore.h"
+#include "dbixlog.h"
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QtEndian>
+#include <cstring>
+
+namespace Dbixwall {
+
+    // file layout: the magic, then records of
+    //   quint32 payload size, quint16 qChecksum of the payload, quint16 version
+    //   payload: quint64 block number, transaction index and nonce, then the hash,
+    //   sender, receiver, value, block hash, gas, gas price and input as quint32
+    //   size prefixed UTF-8, all integers little endian
+    static const char sMagic[] = "DBXTXLOG";
+    static const int MAGIC_SIZE = 8;
+    static const int RECORD_HEADER = 8;
+    static const quint16 RECORD_VERSION = 1;
+    static const int FIXED_FIELDS = 24;
+    static const int COMPACT_MIN = 1024; // superseded records tolerated before compacting
+
+    static void putUInt64(QByteArray& out, quint64 value) {
+        uchar bytes[8];
+        qToLittleEndian<quint64>(value, bytes);
+        out.append((const char*)bytes, 8);
+    }
+
+    static void putString(QByteArray& out, const QString& value) {
+        const QByteArray utf8 = value.toUtf8();
+        uchar size[4];
+        qToLittleEndian<quint32>(utf8.size(), size);
+        out.append((const char*)size, 4);
+        out.append(utf8);
+    }
+
+    static bool getString(const uchar*& pos, const uchar* end, QString& value) {
+        if ( end - pos < 4 ) {
+            return false;
+        }
+
+        const quint32 size = qFromLittleEndian<quint32>(pos);
+        pos += 4;
+        if ( (quint64)(end - pos) < size ) {
+            return false;
+        }
+
+        value = QString::fromUtf8((const char*)pos, size);
+        pos += size;
+        return true;
+    }
+
+    TransactionStore::TransactionStore() :
+        fFile(), fMap(0), fMapSize(0), fIndex(), fEntries(), fRecordCount(0), fReadOnly(false)
+    {
+    }
+
+    TransactionStore::~TransactionStore() {
+        close();
+    }
+
+    bool TransactionStore::open(const QString& path, bool readOnly) {
+        close();
+        fReadOnly = readOnly;
+        fFile.setFileName(path);
+        if ( readOnly && !fFile.exists() ) {
+            return false; // nothing stored yet
+        }
+
+        if ( !fFile.open(readOnly ? QIODevice::ReadOnly : QIODevice::ReadWrite) ) {
+            DbixLog::logMsg("Unable to open transaction store " + path + ": " + fFile.errorString(), LS_Error);
+            return false;
+        }
+
+        if ( readOnly && fFile.size() < MAGIC_SIZE ) {
+            close();
+            return false;
+        } else if ( fFile.size() < MAGIC_SIZE ) { // new, or we died before the magic made it to disk
+            if ( !fFile.resize(0) || fFile.write(sMagic, MAGIC_SIZE) != MAGIC_SIZE || !fFile.flush() ) {
+                DbixLog::logMsg("Unable to initialize transaction store: " + fFile.errorString(), LS_Error);
+                close();
+                return false;
+            }
+        } else {
+            char magic[MAGIC_SIZE];
+            if ( fFile.read(magic, MAGIC_SIZE) != MAGIC_SIZE || memcmp(magic, sMagic, MAGIC_SIZE) != 0 ) {
+                DbixLog::logMsg("Not a transaction store: " + path, LS_Error);
+                close();
+                return false;
+            }
+        }
+
+        if ( !scan() ) {
+            close();
+            return false;
+        }
+
+        if ( !fReadOnly && fRecordCount - fIndex.size() > qMax(fIndex.size(), COMPACT_MIN) ) {
+            compact(); // keeps the current log if it fails
+        }
+
+        return isOpen();
+    }
+
+    void TransactionStore::close() {
+        unmap();
+        if ( fFile.isOpen() ) {
+            fFile.close();
+        }
+
+        fIndex.clear();
+        fEntries.clear();
+        fRecordCount = 0;
+    }
+
+    bool TransactionStore::isOpen() const {
+        return fFile.isOpen();
+    }
+
+    int TransactionStore::size() const {
+        return fIndex.size();
+    }
+
+    bool TransactionStore::append(const TransactionInfo& info) {
+        if ( !isOpen() || fReadOnly ) {
+            return false;
+        }
+
+        const QByteArray record = encodeRecord(info);
+        const QHash<QString, Entry>::const_iterator stored = fEntries.constFind(info.fHash);
+        if ( stored != fEntries.constEnd() ) { // model refreshes re-store everything, don't grow the log for that
+            const qint64 offset = stored.value().fOffset;
+            const uchar* data = mapped(offset + RECORD_HEADER);
+            if ( data != 0 && qFromLittleEndian<quint32>(data + offset) + RECORD_HEADER == (quint32)record.size() ) {
+                data = mapped(offset + record.size());
+                if ( data != 0 && memcmp(data + offset, record.constData(), record.size()) == 0 ) {
+                    return true;
+                }
+            }
+        }
+
+        const qint64 offset = fFile.size();
+        if ( !fFile.seek(offset) || fFile.write(record) != record.size() || !fFile.flush() ) {
+            DbixLog::logMsg("Unable to store transaction " + info.fHash + ": " + fFile.errorString(), LS_Error);
+            fFile.resize(offset); // don't leave a torn record behind
+            return false;
+        }
+
+        indexRecord(info.fHash, info.fBlockNumber, info.fTransactionIndex, offset);
+        fRecordCount++;
+        return true;
+    }
+
+    const TransactionList TransactionStore::readAll() const {
+        TransactionList result;
+        result.reserve(fIndex.size());
+        foreach ( const Entry& entry, fIndex ) {
+            result.append(readRecord(entry.fOffset));
+        }
+
+        return result;
+    }
+
+    const TransactionList TransactionStore::readRange(quint64 fromBlock, quint64 toBlock) const {
+        TransactionList result;
+        for ( int i = lowerBound(fromBlock, 0); i < fIndex.size() && fIndex.at(i).fBlock <= toBlock; i++ ) {
+            result.append(readRecord(fIndex.at(i).fOffset));
+        }
+
+        return result;
+    }
+
+    const QString TransactionStore::defaultPath() {
+        return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/transactions.log";
+    }
+
+    const uchar* TransactionStore::mapped(qint64 end) const {
+        if ( fMap != 0 && fMapSize >= end ) {
+            return fMap;
+        }
+
+        unmap();
+        const qint64 fileSize = fFile.size();
+        if ( fileSize < end || fileSize == 0 ) {
+            return 0;
+        }
+
+        fMap = fFile.map(0, fileSize);
+        fMapSize = fMap != 0 ? fileSize : 0;
+        return fMap;
+    }
+
+    void TransactionStore::unmap() const {
+        if ( fMap != 0 ) {
+            fFile.unmap(fMap);
+            fMap = 0;
+            fMapSize = 0;
+        }
+    }
+
+    bool TransactionStore::scan() {
+        const qint64 fileSize = fFile.size();
+        const uchar* data = mapped(fileSize);
+        if ( data == 0 ) {
+            DbixLog::logMsg("Unable to map transaction store: " + fFile.errorString(), LS_Error);
+            return false;
+        }
+
+        qint64 pos = MAGIC_SIZE;
+        while ( pos < fileSize ) {
+            quint32 size = 0;
+            QString hash;
+            quint64 block = 0;
+            quint64 transactionIndex = 0;
+            if ( !peekRecord(data + pos, fileSize - pos, size, hash, block, transactionIndex) ) {
+                if ( fReadOnly ) {
+                    break; // possibly a record still being written by the owner
+                }
+
+                DbixLog::logMsg("Dropping " + QString::number(fileSize - pos) + " damaged bytes at the end of the transaction store", LS_Warning);
+                unmap();
+                if ( !fFile.resize(pos) ) {
+                    DbixLog::logMsg("Unable to truncate transaction store: " + fFile.errorString(), LS_Error);
+                    return false;
+                }
+                break;
+            }
+
+            indexRecord(hash, block, transactionIndex, pos);
+            fRecordCount++;
+            pos += RECORD_HEADER + size;
+        }
+
+        return true;
+    }
+
+    // rewrites only the live records, atomically replacing the log
+    bool TransactionStore::compact() {
+        const QString path = fFile.fileName();
+        const uchar* data = mapped(fFile.size());
+        QSaveFile out(path);
+        if ( data == 0 || !out.open(QIODevice::WriteOnly) || out.write(sMagic, MAGIC_SIZE) != MAGIC_SIZE ) {
+            return false;
+        }
+
+        foreach ( const Entry& entry, fIndex ) {
+            const qint64 size = RECORD_HEADER + qFromLittleEndian<quint32>(data + entry.fOffset);
+            if ( out.write((const char*)data + entry.fOffset, size) != size ) {
+                out.cancelWriting();
+                return false;
+            }
+        }
+
+        const int superseded = fRecordCount - fIndex.size();
+        close(); // the log can't be replaced while it's open and mapped on some platforms
+        const bool committed = out.commit();
+        fFile.setFileName(path);
+        if ( !fFile.open(QIODevice::ReadWrite) || !scan() ) {
+            DbixLog::logMsg("Unable to reopen transaction store: " + fFile.errorString(), LS_Error);
+            close();
+            return false;
+        }
+
+        if ( committed ) {
+            DbixLog::logMsg("Compacted transaction store, dropped " + QString::number(superseded) + " superseded records", LS_Debug);
+        }
+
+        return committed;
+    }
+
+    void TransactionStore::indexRecord(const QString& hash, quint64 block, quint64 transactionIndex, qint64 offset) {
+        const QHash<QString, Entry>::const_iterator stored = fEntries.constFind(hash);
+        if ( stored != fEntries.constEnd() ) {
+            const int index = findEntry(stored.value());
+            if ( index >= 0 ) {
+                fIndex.remove(index);
+            }
+        }
+
+        Entry entry;
+        entry.fBlock = block;
+        entry.fTransactionIndex = transactionIndex;
+        entry.fOffset = offset;
+        fIndex.insert(upperBound(block, transactionIndex), entry); // mostly at the end
+        fEntries.insert(hash, entry);
+    }
+
+    int TransactionStore::findEntry(const Entry& entry) const {
+        for ( int i = lowerBound(entry.fBlock, entry.fTransactionIndex); i < fIndex.size(); i++ ) {
+            const Entry& candidate = fIndex.at(i);
+            if ( candidate.fBlock != entry.fBlock || candidate.fTransactionIndex != entry.fTransactionIndex ) {
+                break;
+            }
+
+            if ( candidate.fOffset == entry.fOffset ) {
+                return i;
+            }
+        }
+
+        return -1;
+    }
+
+    int TransactionStore::lowerBound(quint64 block, quint64 transactionIndex) const {
+        int low = 0;
+        int high = fIndex.size();
+        while ( low < high ) {
+            const int mid = (low + high) / 2;
+            const Entry& entry = fIndex.at(mid);
+            if ( entry.fBlock < block || ( entry.fBlock == block && entry.fTransactionIndex < transactionIndex ) ) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+
+        return low;
+    }
+
+    int TransactionStore::upperBound(quint64 block, quint64 transactionIndex) const {
+        int low = 0;
+        int high = fIndex.size();
+        while ( low < high ) {
+            const int mid = (low + high) / 2;
+            const Entry& entry = fIndex.at(mid);
+            if ( entry.fBlock < block || ( entry.fBlock == block && entry.fTransactionIndex <= transactionIndex ) ) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+
+        return low;
+    }
+
+    const TransactionInfo TransactionStore::readRecord(qint64 offset) const {
+        TransactionInfo info;
+        const uchar* data = mapped(offset + RECORD_HEADER);
+        if ( data == 0 ) {
+            return info;
+        }
+
+        const quint32 size = qFromLittleEndian<quint32>(data + offset);
+        data = mapped(offset + RECORD_HEADER + size);
+        if ( data == 0 || size < FIXED_FIELDS ) {
+            return info;
+        }
+
+        const uchar* pos = data + offset + RECORD_HEADER;
+        const uchar* end = pos + size;
+        info.fBlockNumber = qFromLittleEndian<quint64>(pos);
+        info.fTransactionIndex = qFromLittleEndian<quint64>(pos + 8);
+        info.fNonce = qFromLittleEndian<quint64>(pos + 16);
+        pos += FIXED_FIELDS;
+
+        if ( !getString(pos, end, info.fHash) || !getString(pos, end, info.fSender) || !getString(pos, end, info.fReceiver) ||
+             !getString(pos, end, info.fValue) || !getString(pos, end, info.fBlockHash) || !getString(pos, end, info.fGas) ||
+             !getString(pos, end, info.fGasPrice) || !getString(pos, end, info.fInput) ) {
+            DbixLog::logMsg("Damaged transaction store record", LS_Error); // scan() checked it, shouldn't happen
+        }
+
+        return info;
+    }
+
+    const QByteArray TransactionStore::encodeRecord(const TransactionInfo& info) {
+        QByteArray payload;
+        payload.reserve(FIXED_FIELDS + 8 * 4 + info.fHash.size() + info.fSender.size() + info.fReceiver.size() + info.fValue.size() +
+                        info.fBlockHash.size() + info.fGas.size() + info.fGasPrice.size() + info.fInput.size());
+        putUInt64(payload, info.fBlockNumber);
+        putUInt64(payload, info.fTransactionIndex);
+        putUInt64(payload, info.fNonce);
+        putString(payload, info.fHash);
+        putString(payload, info.fSender);
+        putString(payload, info.fReceiver);
+        putString(payload, info.fValue);
+        putString(payload, info.fBlockHash);
+        putString(payload, info.fGas);
+        putString(payload, info.fGasPrice);
+        putString(payload, info.fInput);
+
+        QByteArray result(RECORD_HEADER, '\0');
+        uchar* header = (uchar*)result.data();
+        qToLittleEndian<quint32>(payload.size(), header);
+        qToLittleEndian<quint16>(qChecksum(payload.constData(), payload.size()), header + 4);
+        qToLittleEndian<quint16>(RECORD_VERSION, header + 6);
+
+        return result + payload;
+    }
+
+    // validates the record at data and reads what the index needs from it
+    bool TransactionStore::peekRecord(const uchar* data, qint64 available, quint32& size, QString& hash, quint64& block, quint64& transactionIndex) {
+        if ( available < RECORD_HEADER ) {
+            return false;
+        }
+
+        size = qFromLittleEndian<quint32>(data);
+        if ( size < FIXED_FIELDS || (quint64)size > (quint64)(available - RECORD_HEADER) ) {
+            return false;
+        }
+
+        const char* payload = (const char*)data + RECORD_HEADER;
+        if ( qFromLittleEndian<quint16>(data + 6) != RECORD_VERSION ||
+             qFromLittleEndian<quint16>(data + 4) != qChecksum(payload, size) ) {
+            return false;
+        }
+
+        block = qFromLittleEndian<quint64>(data + RECORD_HEADER);
+        transactionIndex = qFromLittleEndian<quint64>(data + RECORD_HEADER + 8);
+
+        const uchar* pos = data + RECORD_HEADER + FIXED_FIELDS;
+        const uchar* end = data + RECORD_HEADER + size;
+        if ( !getString(pos, end, hash) ) {
+            return false;
+        }
+
+        for ( int i = 1; i < 8; i++ ) { // make sure the rest of the fields are intact too
+            if ( end - pos < 4 ) {
+                return false;
+            }
+
+            const quint32 fieldSize = qFromLittleEndian<quint32>(pos);
+            pos += 4;
+            if ( (quint64)(end - pos) < fieldSize ) {
+                return false;
+            }
+            pos += fieldSize;
+        }
+
+        return pos == end;
+    }
+
+}
@@ -0,0 +1,78 @@
+/*
+    This file is part of dbixwall.
+    dbixwall is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    dbixwall is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with dbixwall. If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file transactionstore.h
+ * @date 2026
+ *
+ * Append only transaction log header
+ */
+
+#ifndef TRANSACTIONSTORE_H
+#define TRANSACTIONSTORE_H
+
+#include <QFile>
+#include <QHash>
+#include <QVector>
+#include "types.h"
+
+namespace Dbixwall {
+
+    // append only binary log of our transactions, read back through a memory map.
+    // A transaction is never rewritten in place, a newer record with the same hash
+    // supersedes the older one and the log gets compacted on open once most of it
+    // is superseded. A torn record at the tail (crash mid write) is cut off on open.
+    class TransactionStore
+    {
+    public:
+        TransactionStore();
+        ~TransactionStore();
+
+        bool open(const QString& path, bool readOnly = false); // read only leaves the file exactly as it is
+        void close();
+        bool isOpen() const;
+        int size() const; // live transactions
+        bool append(const TransactionInfo& info); // skips records identical to the stored one
+        const TransactionList readAll() const; // by block and transaction index, oldest first
+        const TransactionList readRange(quint64 fromBlock, quint64 toBlock) const; // inclusive, same order
+        static const QString defaultPath();
+    private:
+        struct Entry {
+            quint64 fBlock;
+            quint64 fTransactionIndex;
+            qint64 fOffset;
+        };
+
+        mutable QFile fFile;
+        mutable uchar* fMap;
+        mutable qint64 fMapSize;
+        QVector<Entry> fIndex; // live records in block order
+        QHash<QString, Entry> fEntries; // hash -> live record
+        int fRecordCount; // live and superseded
+        bool fReadOnly;
+
+        const uchar* mapped(qint64 end) const; // maps at least up to end, 0 if the file is shorter
+        void unmap() const;
+        bool scan();
+        bool compact();
+        void indexRecord(const QString& hash, quint64 block, quint64 transactionIndex, qint64 offset);
+        int findEntry(const Entry& entry) const;
+        int lowerBound(quint64 block, quint64 transactionIndex) const; // first entry not before
+        int upperBound(quint64 block, quint64 transactionIndex) const; // first entry after
+        const TransactionInfo readRecord(qint64 offset) const;
+        static const QByteArray encodeRecord(const TransactionInfo& info);
+        static bool peekRecord(const uchar* data, qint64 available, quint32& size, QString& hash, quint64& block, quint64& transactionIndex);
+    };
+
+}
+
+#endif // TRANSACTIONSTORE_H
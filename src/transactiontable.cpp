@@ -0,0 +1,376 @@
+/*
+    This file is part of dbixwall.
+    dbixwall is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    dbixwall is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with dbixwall. If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file transactiontable.cpp
+ * @date 2026
+ *
+ * Column store for the transaction model rows
+ */
+
+#include "transactiontable.h"
+#include "helpers.h"
+#include "hexcodec.h"
+#include <cstring>
+
+namespace Dbixwall {
+
+    enum TableColumn {
+        HashColumn,
+        SenderColumn,
+        ReceiverColumn,
+        ValueColumn,
+        BlockHashColumn,
+        GasColumn,
+        GasPriceColumn,
+        InputColumn
+    };
+
+    static const int DISPLAY_CACHE_ROWS = 256; // a few screens worth
+    static const int MIN_INPUT_GARBAGE = 1024 * 1024;
+
+    static const QString formatHex(const uchar* data, int size) {
+        QByteArray result(2 + size * 2, Qt::Uninitialized);
+        result[0] = '0';
+        result[1] = 'x';
+        HexCodec::encode(data, size, result.data() + 2);
+        return QString::fromLatin1(result);
+    }
+
+    // "0x" and lowercase hex is the only form stored compact, anything else would
+    // come back different
+    static bool parseHex(const QString& text, uchar* out, int size) {
+        if ( text.length() != 2 + size * 2 || !text.startsWith("0x") ) {
+            return false;
+        }
+
+        const QByteArray latin = text.toLatin1();
+        for ( int i = 2; i < latin.size(); i++ ) {
+            if ( latin.at(i) >= 'A' && latin.at(i) <= 'F' ) {
+                return false;
+            }
+        }
+
+        return HexCodec::decode(latin.constData() + 2, size * 2, out);
+    }
+
+    static const QString formatAddress(const uchar* data) {
+        return Helpers::vitalizeAddress(formatHex(data, 20));
+    }
+
+    // only checksummed addresses are stored compact, they're formatted back that way
+    static bool parseAddress(const QString& text, uchar* out) {
+        const QString lower = text.toLower();
+        return parseHex(lower, out, 20) && formatAddress(out) == text;
+    }
+
+    static bool parseAmount(const QString& text, int decimals, UInt256& out) {
+        bool ok = false;
+        out = decimals > 0 ? UInt256::fromDecimal(text, decimals, &ok) : UInt256::fromDec(text, &ok);
+        return ok && (decimals > 0 ? out.toDec(decimals) : out.toDec()) == text;
+    }
+
+    TransactionTable::TransactionTable() :
+        fInputGarbage(0), fNextId(0), fDisplay(DISPLAY_CACHE_ROWS)
+    {
+    }
+
+    int TransactionTable::size() const {
+        return fIds.size();
+    }
+
+    void TransactionTable::clear() {
+        fIds.clear();
+        fSpilled.clear();
+        fHashes.clear();
+        fBlockHashes.clear();
+        fSenders.clear();
+        fReceivers.clear();
+        fNonces.clear();
+        fBlockNumbers.clear();
+        fTransactionIndexes.clear();
+        fValues.clear();
+        fGas.clear();
+        fGasPrices.clear();
+        fInputOffsets.clear();
+        fInputSizes.clear();
+        fSenderAliases.clear();
+        fReceiverAliases.clear();
+        fInputs.clear();
+        fInputGarbage = 0;
+        fSpill.clear();
+        fDisplay.clear();
+    }
+
+    void TransactionTable::assign(const TransactionList& list) {
+        clear();
+
+        const int count = list.size();
+        fIds.resize(count);
+        fSpilled.resize(count);
+        fHashes.resize(count);
+        fBlockHashes.resize(count);
+        fSenders.resize(count);
+        fReceivers.resize(count);
+        fNonces.resize(count);
+        fBlockNumbers.resize(count);
+        fTransactionIndexes.resize(count);
+        fValues.resize(count);
+        fGas.resize(count);
+        fGasPrices.resize(count);
+        fInputOffsets.resize(count);
+        fInputSizes.resize(count);
+        fSenderAliases.resize(count);
+        fReceiverAliases.resize(count);
+
+        for ( int i = 0; i < count; i++ ) {
+            setRow(i, list.at(i));
+        }
+    }
+
+    void TransactionTable::insert(int row, const TransactionInfo& info) {
+        fIds.insert(row, 0);
+        fSpilled.insert(row, 0);
+        fHashes.insert(row, Hash());
+        fBlockHashes.insert(row, Hash());
+        fSenders.insert(row, Address());
+        fReceivers.insert(row, Address());
+        fNonces.insert(row, 0);
+        fBlockNumbers.insert(row, 0);
+        fTransactionIndexes.insert(row, 0);
+        fValues.insert(row, UInt256());
+        fGas.insert(row, UInt256());
+        fGasPrices.insert(row, UInt256());
+        fInputOffsets.insert(row, 0);
+        fInputSizes.insert(row, 0);
+        fSenderAliases.insert(row, QString());
+        fReceiverAliases.insert(row, QString());
+
+        setRow(row, info);
+    }
+
+    void TransactionTable::replace(int row, const TransactionInfo& info) {
+        releaseRow(row);
+        setRow(row, info);
+    }
+
+    void TransactionTable::remove(int row) {
+        releaseRow(row);
+
+        fIds.remove(row);
+        fSpilled.remove(row);
+        fHashes.remove(row);
+        fBlockHashes.remove(row);
+        fSenders.remove(row);
+        fReceivers.remove(row);
+        fNonces.remove(row);
+        fBlockNumbers.remove(row);
+        fTransactionIndexes.remove(row);
+        fValues.remove(row);
+        fGas.remove(row);
+        fGasPrices.remove(row);
+        fInputOffsets.remove(row);
+        fInputSizes.remove(row);
+        fSenderAliases.remove(row);
+        fReceiverAliases.remove(row);
+    }
+
+    const TransactionInfo TransactionTable::at(int row) const {
+        TransactionInfo info;
+        info.fHash = text(row, HashColumn);
+        info.fNonce = fNonces.at(row);
+        info.fSender = text(row, SenderColumn);
+        info.fReceiver = text(row, ReceiverColumn);
+        info.fValue = text(row, ValueColumn);
+        info.fBlockNumber = fBlockNumbers.at(row);
+        info.fBlockHash = text(row, BlockHashColumn);
+        info.fTransactionIndex = fTransactionIndexes.at(row);
+        info.fGas = text(row, GasColumn);
+        info.fGasPrice = text(row, GasPriceColumn);
+        info.fInput = text(row, InputColumn);
+        info.fSenderAlias = fSenderAliases.at(row);
+        info.fReceiverAlias = fReceiverAliases.at(row);
+
+        return info;
+    }
+
+    const QVariant TransactionTable::value(int row, int role) const {
+        switch ( role ) {
+            case THashRole: return QVariant(displayText(row, HashColumn));
+            case NonceRole: return QVariant(fNonces.at(row));
+            case SenderRole: return QVariant(displayText(row, SenderColumn));
+            case ReceiverRole: return QVariant(displayText(row, ReceiverColumn));
+            case ValueRole: return QVariant(displayText(row, ValueColumn));
+            case BlockNumberRole: return QVariant(fBlockNumbers.at(row));
+            case BlockHashRole: return QVariant(displayText(row, BlockHashColumn));
+            case TransactionIndexRole: return QVariant(fTransactionIndexes.at(row));
+            case GasRole: return QVariant(displayText(row, GasColumn));
+            case GasPriceRole: return QVariant(displayText(row, GasPriceColumn));
+            case InputRole: return QVariant(text(row, InputColumn)); // can be big, never cached
+            case SenderAliasRole: return QVariant(fSenderAliases.at(row).isEmpty() ? displayText(row, SenderColumn) : fSenderAliases.at(row));
+            case ReceiverAliasRole: return QVariant(fReceiverAliases.at(row).isEmpty() ? displayText(row, ReceiverColumn) : fReceiverAliases.at(row));
+        }
+
+        return QVariant();
+    }
+
+    const QString TransactionTable::hash(int row) const {
+        return text(row, HashColumn);
+    }
+
+    quint64 TransactionTable::blockNumber(int row) const {
+        return fBlockNumbers.at(row);
+    }
+
+    quint64 TransactionTable::transactionIndex(int row) const {
+        return fTransactionIndexes.at(row);
+    }
+
+    void TransactionTable::setRow(int row, const TransactionInfo& info) {
+        const quint32 id = fNextId++;
+        fIds[row] = id;
+
+        quint8 spilled = 0;
+        if ( !parseHex(info.fHash, fHashes[row].fBytes, 32) ) {
+            spill(id, HashColumn, info.fHash);
+            spilled |= 1 << HashColumn;
+        }
+
+        if ( !parseAddress(info.fSender, fSenders[row].fBytes) ) {
+            spill(id, SenderColumn, info.fSender);
+            spilled |= 1 << SenderColumn;
+        }
+
+        if ( !parseAddress(info.fReceiver, fReceivers[row].fBytes) ) { // empty for contract deployments
+            spill(id, ReceiverColumn, info.fReceiver);
+            spilled |= 1 << ReceiverColumn;
+        }
+
+        if ( !parseAmount(info.fValue, 18, fValues[row]) ) {
+            spill(id, ValueColumn, info.fValue);
+            spilled |= 1 << ValueColumn;
+        }
+
+        if ( !parseHex(info.fBlockHash, fBlockHashes[row].fBytes, 32) ) { // "invalid" while pending
+            spill(id, BlockHashColumn, info.fBlockHash);
+            spilled |= 1 << BlockHashColumn;
+        }
+
+        if ( !parseAmount(info.fGas, 0, fGas[row]) ) {
+            spill(id, GasColumn, info.fGas);
+            spilled |= 1 << GasColumn;
+        }
+
+        if ( !parseAmount(info.fGasPrice, 18, fGasPrices[row]) ) {
+            spill(id, GasPriceColumn, info.fGasPrice);
+            spilled |= 1 << GasPriceColumn;
+        }
+
+        fInputOffsets[row] = fInputs.size();
+        fInputSizes[row] = 0;
+        const int inputSize = (info.fInput.length() - 2) / 2;
+        bool inputStored = false;
+        if ( info.fInput.length() % 2 == 0 && inputSize >= 0 ) {
+            fInputs.resize(fInputs.size() + inputSize);
+            inputStored = parseHex(info.fInput, (uchar*)fInputs.data() + fInputOffsets.at(row), inputSize);
+            if ( inputStored ) {
+                fInputSizes[row] = inputSize;
+            } else {
+                fInputs.resize(fInputOffsets.at(row));
+            }
+        }
+
+        if ( !inputStored ) {
+            spill(id, InputColumn, info.fInput);
+            spilled |= 1 << InputColumn;
+        }
+
+        fNonces[row] = info.fNonce;
+        fBlockNumbers[row] = info.fBlockNumber;
+        fTransactionIndexes[row] = info.fTransactionIndex;
+        fSenderAliases[row] = info.fSenderAlias;
+        fReceiverAliases[row] = info.fReceiverAlias;
+        fSpilled[row] = spilled;
+    }
+
+    void TransactionTable::releaseRow(int row) {
+        const quint64 id = fIds.at(row);
+        for ( int column = HashColumn; column <= InputColumn; column++ ) {
+            if ( fSpilled.at(row) & (1 << column) ) {
+                fSpill.remove(id << 8 | column);
+            }
+        }
+
+        fSpilled[row] = 0;
+        fDisplay.remove(fIds.at(row));
+        fInputGarbage += fInputSizes.at(row);
+        fInputSizes[row] = 0;
+
+        if ( fInputGarbage > MIN_INPUT_GARBAGE && fInputGarbage > fInputs.size() / 2 ) {
+            compactInputs();
+        }
+    }
+
+    void TransactionTable::compactInputs() {
+        QByteArray inputs;
+        inputs.reserve(fInputs.size() - fInputGarbage);
+        for ( int i = 0; i < fInputSizes.size(); i++ ) {
+            const quint32 offset = inputs.size();
+            inputs.append(fInputs.constData() + fInputOffsets.at(i), fInputSizes.at(i));
+            fInputOffsets[i] = offset;
+        }
+
+        fInputs = inputs;
+        fInputGarbage = 0;
+    }
+
+    void TransactionTable::spill(quint32 id, int column, const QString& text) {
+        fSpill.insert((quint64)id << 8 | column, text);
+    }
+
+    const QString TransactionTable::text(int row, int column) const {
+        if ( fSpilled.at(row) & (1 << column) ) {
+            return fSpill.value((quint64)fIds.at(row) << 8 | column);
+        }
+
+        switch ( column ) {
+            case HashColumn: return formatHex(fHashes.at(row).fBytes, 32);
+            case SenderColumn: return formatAddress(fSenders.at(row).fBytes);
+            case ReceiverColumn: return formatAddress(fReceivers.at(row).fBytes);
+            case ValueColumn: return fValues.at(row).toDec(18);
+            case BlockHashColumn: return formatHex(fBlockHashes.at(row).fBytes, 32);
+            case GasColumn: return fGas.at(row).toDec();
+            case GasPriceColumn: return fGasPrices.at(row).toDec(18);
+            case InputColumn: return formatHex((const uchar*)fInputs.constData() + fInputOffsets.at(row), fInputSizes.at(row));
+        }
+
+        return QString();
+    }
+
+    const QString TransactionTable::displayText(int row, int column) const {
+        const quint32 id = fIds.at(row);
+        DisplayRow* cached = fDisplay.object(id);
+        if ( cached == 0 ) {
+            cached = new DisplayRow();
+            cached->fFilled = 0;
+            fDisplay.insert(id, cached);
+        }
+
+        if ( !(cached->fFilled & (1 << column)) ) {
+            cached->fText[column] = text(row, column);
+            cached->fFilled |= 1 << column;
+        }
+
+        return cached->fText[column];
+    }
+
+}
@@ -0,0 +1,100 @@
+/*
+    This file is part of dbixwall.
+    dbixwall is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    dbixwall is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with dbixwall. If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file transactiontable.h
+ * @date 2026
+ *
+ * Column store for the transaction model rows header
+ */
+
+#ifndef TRANSACTIONTABLE_H
+#define TRANSACTIONTABLE_H
+
+#include <QVector>
+#include <QHash>
+#include <QCache>
+#include <QVariant>
+#include "types.h"
+#include "uint256.h"
+
+namespace Dbixwall {
+
+    // TransactionModel rows kept column by column in binary form: 32 byte hashes,
+    // 20 byte addresses, 256 bit amounts and the inputs in one shared byte arena.
+    // Display strings are only built when a row is shown and then cached by row id,
+    // which survives row shifts. Text without a compact form ("invalid", an empty
+    // receiver, a non canonical amount) is kept verbatim so nothing changes on screen.
+    class TransactionTable
+    {
+    public:
+        TransactionTable();
+
+        int size() const;
+        void clear();
+        void assign(const TransactionList& list);
+        void insert(int row, const TransactionInfo& info);
+        void replace(int row, const TransactionInfo& info);
+        void remove(int row);
+
+        const TransactionInfo at(int row) const;
+        const QVariant value(int row, int role) const; // same as TransactionInfo::value
+        const QString hash(int row) const;
+        quint64 blockNumber(int row) const;
+        quint64 transactionIndex(int row) const;
+    private:
+        struct Hash {
+            uchar fBytes[32];
+        };
+
+        struct Address {
+            uchar fBytes[20];
+        };
+
+        struct DisplayRow {
+            QString fText[7]; // every column but the input
+            quint8 fFilled;
+        };
+
+        QVector<quint32> fIds; // stable row ids for the display cache and spilled text
+        QVector<quint8> fSpilled; // bit per column kept verbatim in fSpill
+        QVector<Hash> fHashes;
+        QVector<Hash> fBlockHashes;
+        QVector<Address> fSenders;
+        QVector<Address> fReceivers;
+        QVector<quint64> fNonces;
+        QVector<quint64> fBlockNumbers;
+        QVector<quint64> fTransactionIndexes;
+        QVector<UInt256> fValues; // wei
+        QVector<UInt256> fGas;
+        QVector<UInt256> fGasPrices; // wei
+        QVector<quint32> fInputOffsets;
+        QVector<quint32> fInputSizes;
+        QVector<QString> fSenderAliases;
+        QVector<QString> fReceiverAliases;
+        QByteArray fInputs; // arena of all the input bytes
+        int fInputGarbage; // arena bytes no row points to anymore
+        QHash<quint64, QString> fSpill; // (id, column) -> exact text
+        quint32 fNextId;
+        mutable QCache<quint32, DisplayRow> fDisplay;
+
+        void setRow(int row, const TransactionInfo& info);
+        void releaseRow(int row);
+        void compactInputs();
+        void spill(quint32 id, int column, const QString& text);
+        const QString text(int row, int column) const;
+        const QString displayText(int row, int column) const;
+    };
+
+}
+
+#endif // TRANSACTIONTABLE_H
@@ -85,19 +85,19 @@ namespace Dbixwall {
 
     // ***************************** Denomination ***************************** //
 
-    CurrencyInfo::CurrencyInfo( const QString name, const float price ) : fName(name), fPrice(price) {
+    CurrencyInfo::CurrencyInfo( const QString name, const FixedDecimal& price ) : fName(name), fPrice(price) {
     }
 
     const QVariant CurrencyInfo::value(const int role) const {
         switch ( role ) {
         case NameRole: return QVariant(fName);
-        case PriceRole: return QVariant(fPrice);
+        case PriceRole: return QVariant(fPrice.toDouble());
         }
 
         return QVariant();
     }
 
-    double CurrencyInfo::recalculate(const float dbix) const {
+    const FixedDecimal CurrencyInfo::recalculate(const FixedDecimal& dbix) const {
         return dbix * fPrice;
     }
 
@@ -196,6 +196,10 @@ namespace Dbixwall {
         fBlockNumber = num;
     }
 
+    quint64 TransactionInfo::getTransactionIndex() const {
+        return fTransactionIndex;
+    }
+
     const QString TransactionInfo::getHash() const {
         return fHash;
     }
@@ -284,5 +288,26 @@ namespace Dbixwall {
         return doc.toJson(QJsonDocument::Compact);
     }
 
-}
+    // ***************************** BlockInfo ***************************** //
+
+    BlockInfo::BlockInfo() : fNumber(0)
+    {
+    }
+
+    quint64 BlockInfo::number() const {
+        return fNumber;
+    }
 
+    const QString BlockInfo::hash() const {
+        return fHash;
+    }
+
+    const QString BlockInfo::miner() const {
+        return fMiner;
+    }
+
+    const TransactionList& BlockInfo::transactions() const {
+        return fTransactions;
+    }
+
+}
@@ -28,6 +28,7 @@
 #include <QStandardPaths>
 #include <QJsonObject>
 #include <QJsonValue>
+#include "fixeddecimal.h"
 #include <QJsonArray>
 #include <QDateTime>
 
@@ -106,12 +107,12 @@ namespace Dbixwall {
     class CurrencyInfo
     {
     public:
-        CurrencyInfo( const QString name, const float price );
+        CurrencyInfo( const QString name, const FixedDecimal& price );
         const QVariant value(const int role) const;
-        double recalculate(const float dbix) const;
+        const FixedDecimal recalculate(const FixedDecimal& dbix) const;
     private:
         QString fName;
-        float fPrice;
+        FixedDecimal fPrice;
     };
 
     typedef QList<CurrencyInfo> CurrencyInfos;
@@ -139,7 +140,9 @@ namespace Dbixwall {
         GetNetVersion,
         GetSyncing,
         GetLogs,
-        GetTransactionReceipt
+        GetTransactionReceipt,
+        SubscribeNewHeads,
+        SubscribeLogs
     };
 
     enum AccountRoles {
@@ -202,6 +205,7 @@ namespace Dbixwall {
         const QVariant value(const int role) const;
         quint64 getBlockNumber() const;
         void setBlockNumber(quint64 num);
+        quint64 getTransactionIndex() const;
         const QString getHash() const;
         void setHash(const QString& hash);
         void init(const QString& from, const QString& to, const QString& value, const QString& gas = QString(),
@@ -224,10 +228,32 @@ namespace Dbixwall {
         QString fInput;
         QString fSenderAlias;
         QString fReceiverAlias;
+
+        friend class ReplyParser;
+        friend class TransactionStore;
+        friend class TransactionTable;
     };
 
     typedef QList<TransactionInfo> TransactionList;
 
+    class BlockInfo
+    {
+    public:
+        BlockInfo();
+
+        quint64 number() const;
+        const QString hash() const;
+        const QString miner() const;
+        const TransactionList& transactions() const;
+    private:
+        quint64 fNumber;
+        QString fHash;
+        QString fMiner;
+        TransactionList fTransactions;
+
+        friend class ReplyParser;
+    };
+
 }
 
 #endif // TYPES_H
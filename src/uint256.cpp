@@ -0,0 +1,643 @@
+/*
+    This file is part of dbixwall.
+    dbixwall is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    dbixwall is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with dbixwall. If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file uint256.cpp
+ * @date 2026
+ *
+ * Fixed width 256 bit unsigned integer
+ */
+
+#include "uint256.h"
+#include <cstring>
+
+namespace Dbixwall {
+
+    static const int DEC_CHUNK_DIGITS = 19;
+    static Q_DECL_CONSTEXPR const quint64 DEC_CHUNK = powerOfTen(DEC_CHUNK_DIGITS); // the largest power of ten in a limb
+
+    static Q_DECL_CONSTEXPR const quint64 sPowersOfTen[DEC_CHUNK_DIGITS + 1] = {
+        powerOfTen(0), powerOfTen(1), powerOfTen(2), powerOfTen(3), powerOfTen(4),
+        powerOfTen(5), powerOfTen(6), powerOfTen(7), powerOfTen(8), powerOfTen(9),
+        powerOfTen(10), powerOfTen(11), powerOfTen(12), powerOfTen(13), powerOfTen(14),
+        powerOfTen(15), powerOfTen(16), powerOfTen(17), powerOfTen(18), powerOfTen(19)
+    };
+
+    // full 64x64 -> 128 bit product
+    static inline void mul64(quint64 a, quint64 b, quint64& hi, quint64& lo) {
+#ifdef __SIZEOF_INT128__
+        const unsigned __int128 product = (unsigned __int128)a * b;
+        hi = (quint64)(product >> 64);
+        lo = (quint64)product;
+#else
+        const quint64 aLo = a & 0xffffffff, aHi = a >> 32;
+        const quint64 bLo = b & 0xffffffff, bHi = b >> 32;
+        const quint64 ll = aLo * bLo;
+        const quint64 lh = aLo * bHi;
+        const quint64 hl = aHi * bLo;
+        const quint64 hh = aHi * bHi;
+        const quint64 mid = (ll >> 32) + (lh & 0xffffffff) + (hl & 0xffffffff);
+        hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+        lo = (mid << 32) | (ll & 0xffffffff);
+#endif
+    }
+
+    // (hi:lo) / divisor, hi must be below divisor so the quotient fits a limb
+    static inline quint64 div128(quint64 hi, quint64 lo, quint64 divisor, quint64& remainder) {
+#ifdef __SIZEOF_INT128__
+        const unsigned __int128 dividend = ((unsigned __int128)hi << 64) | lo;
+        remainder = (quint64)(dividend % divisor);
+        return (quint64)(dividend / divisor);
+#else
+        quint64 quotient = 0;
+        for ( int i = 63; i >= 0; i-- ) {
+            const bool carry = (hi >> 63) != 0;
+            hi = (hi << 1) | (lo >> 63);
+            lo <<= 1;
+            quotient <<= 1;
+            if ( carry || hi >= divisor ) {
+                hi -= divisor;
+                quotient |= 1;
+            }
+        }
+        remainder = hi;
+        return quotient;
+#endif
+    }
+
+    // nibble value per character, -1 for anything that isn't a hex digit
+    static const signed char sHexDigits[256] = {
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1,
+        -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+    };
+
+    static const char sDigitPairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+    // limbs are filled from the least significant end, 16 nibbles at a time
+    template <typename Char>
+    static bool parseHex(const Char* data, int size, quint64* limbs) {
+        int start = 0;
+        if ( size > 1 && data[0] == '0' && ( data[1] == 'x' || data[1] == 'X' ) ) {
+            start = 2;
+        }
+
+        while ( start < size && data[start] == '0' ) {
+            start++;
+        }
+
+        if ( size - start > 64 ) {
+            return false; // overflow
+        }
+
+        int limb = 0;
+        int end = size;
+        while ( end > start ) {
+            const int begin = qMax(start, end - 16);
+            quint64 value = 0;
+            for ( int i = begin; i < end; i++ ) {
+                const uint c = (uint)data[i];
+                const int nibble = c < 256 ? sHexDigits[c] : -1;
+                if ( nibble < 0 ) {
+                    return false;
+                }
+                value = (value << 4) | nibble;
+            }
+
+            limbs[limb++] = value;
+            end = begin;
+        }
+
+        return true;
+    }
+
+    // exactly 19 digits, two at a time
+    static inline char* writeChunk(char* pos, quint64 chunk) {
+        for ( int i = 0; i < 9; i++ ) {
+            const int pair = (int)(chunk % 100) * 2;
+            chunk /= 100;
+            *--pos = sDigitPairs[pair + 1];
+            *--pos = sDigitPairs[pair];
+        }
+        *--pos = (char)('0' + chunk);
+        return pos;
+    }
+
+    UInt256::UInt256() {
+        fLimbs[0] = fLimbs[1] = fLimbs[2] = fLimbs[3] = 0;
+    }
+
+    UInt256::UInt256(quint64 value) {
+        fLimbs[0] = value;
+        fLimbs[1] = fLimbs[2] = fLimbs[3] = 0;
+    }
+
+    const UInt256 UInt256::fromHex(const QString& hex, bool* ok) {
+        UInt256 result;
+        const bool parsed = parseHex(hex.utf16(), hex.length(), result.fLimbs);
+        if ( ok != 0 ) {
+            *ok = parsed;
+        }
+
+        return parsed ? result : UInt256();
+    }
+
+    const UInt256 UInt256::fromHex(const char* data, int size, bool* ok) {
+        UInt256 result;
+        const bool parsed = parseHex(data, size, result.fLimbs);
+        if ( ok != 0 ) {
+            *ok = parsed;
+        }
+
+        return parsed ? result : UInt256();
+    }
+
+    // 19 digits at a time, each chunk is one multiply-add over the limbs
+    const UInt256 UInt256::fromDec(const QString& dec, bool* ok) {
+        UInt256 result;
+        if ( ok != 0 ) {
+            *ok = false;
+        }
+
+        const ushort* data = dec.utf16();
+        const int length = dec.length();
+        if ( length == 0 ) {
+            return UInt256();
+        }
+
+        int pos = 0;
+        int chunkDigits = length % DEC_CHUNK_DIGITS;
+        if ( chunkDigits == 0 ) {
+            chunkDigits = DEC_CHUNK_DIGITS;
+        }
+
+        while ( pos < length ) {
+            quint64 chunk = 0;
+            for ( int i = 0; i < chunkDigits; i++ ) {
+                const ushort c = data[pos + i];
+                if ( c < '0' || c > '9' ) {
+                    return UInt256();
+                }
+                chunk = chunk * 10 + (c - '0');
+            }
+
+            if ( result.mulAdd(sPowersOfTen[chunkDigits], chunk) != 0 ) {
+                return UInt256(); // overflow
+            }
+
+            pos += chunkDigits;
+            chunkDigits = DEC_CHUNK_DIGITS;
+        }
+
+        if ( ok != 0 ) {
+            *ok = true;
+        }
+        return result;
+    }
+
+    // digits past the requested decimals are cut off
+    const UInt256 UInt256::fromDecimal(const QString& text, int decimals, bool* ok) {
+        UInt256 result;
+        if ( ok != 0 ) {
+            *ok = false;
+        }
+
+        const ushort* data = text.utf16();
+        const int length = text.length();
+        quint64 chunk = 0;
+        int chunkDigits = 0;
+        int fraction = -1; // digits seen after the point, -1 before it
+        bool digits = false;
+
+        for ( int i = 0; i < length; i++ ) {
+            const ushort c = data[i];
+            if ( c == '.' && fraction < 0 ) {
+                fraction = 0;
+                continue;
+            }
+
+            if ( c < '0' || c > '9' ) {
+                return UInt256();
+            }
+            digits = true;
+
+            if ( fraction >= decimals ) {
+                continue;
+            }
+
+            if ( fraction >= 0 ) {
+                fraction++;
+            }
+
+            chunk = chunk * 10 + (c - '0');
+            if ( ++chunkDigits == DEC_CHUNK_DIGITS ) {
+                if ( result.mulAdd(DEC_CHUNK, chunk) != 0 ) {
+                    return UInt256();
+                }
+                chunk = 0;
+                chunkDigits = 0;
+            }
+        }
+
+        if ( !digits || result.mulAdd(sPowersOfTen[chunkDigits], chunk) != 0 ) { // "" and "." are not zero
+            return UInt256();
+        }
+
+        // scale up by the missing decimals
+        for ( int missing = decimals - qMax(0, fraction); missing > 0; missing -= DEC_CHUNK_DIGITS ) {
+            if ( result.mulAdd(sPowersOfTen[qMin(missing, DEC_CHUNK_DIGITS)], 0) != 0 ) {
+                return UInt256();
+            }
+        }
+
+        if ( ok != 0 ) {
+            *ok = true;
+        }
+        return result;
+    }
+
+    const UInt256 UInt256::max() {
+        return ~UInt256();
+    }
+
+    // division by zero gives zero for both, same as the EVM
+    void UInt256::divMod(const UInt256& dividend, const UInt256& divisor, UInt256& quotient, UInt256& remainder) {
+        if ( divisor.isZero() ) {
+            quotient = UInt256();
+            remainder = UInt256();
+            return;
+        }
+
+        if ( dividend < divisor ) {
+            remainder = dividend;
+            quotient = UInt256();
+            return;
+        }
+
+        if ( divisor.fitsUInt64() ) {
+            quotient = dividend;
+            remainder = UInt256(quotient.divSmall(divisor.fLimbs[0]));
+            return;
+        }
+
+        // wide divisors are rare for us (fixed point scaling mostly), plain shift and subtract
+        UInt256 q;
+        UInt256 r;
+        for ( int i = dividend.bitLength() - 1; i >= 0; i-- ) {
+            const bool carry = r.bit(255); // r < divisor, but 2r may not fit with a divisor over 2^255
+            r = r << 1;
+            r.fLimbs[0] |= dividend.bit(i) ? 1 : 0;
+            if ( carry || r >= divisor ) { // with a carry the true 2r is above the divisor, the wrap cancels out
+                r -= divisor;
+                q.fLimbs[i / 64] |= (quint64)1 << (i % 64);
+            }
+        }
+
+        quotient = q;
+        remainder = r;
+    }
+
+    const QString UInt256::toHex() const {
+        static const char digits[] = "0123456789abcdef";
+        char buffer[64];
+        int pos = 64;
+
+        for ( int i = 0; i < 4; i++ ) {
+            quint64 limb = fLimbs[i];
+            for ( int n = 0; n < 16; n++ ) {
+                buffer[--pos] = digits[limb & 0xf];
+                limb >>= 4;
+            }
+        }
+
+        while ( pos < 63 && buffer[pos] == '0' ) {
+            pos++;
+        }
+
+        return QString::fromLatin1(buffer + pos, 64 - pos);
+    }
+
+    const QString UInt256::toHex(int width) const {
+        const QString hex = toHex();
+        return hex.length() >= width ? hex : QString(width - hex.length(), '0') + hex;
+    }
+
+    const QString UInt256::to0xHex() const {
+        return "0x" + toHex();
+    }
+
+    const QString UInt256::toDec() const {
+        char buffer[80]; // 2^256 has 78 digits
+        char* end = buffer + sizeof(buffer);
+        const char* first = writeDec(end, 1);
+
+        return QString::fromLatin1(first, end - first);
+    }
+
+    const QString UInt256::toDec(int decimals) const {
+        decimals = qBound(0, decimals, 80);
+        char buffer[164];
+        char* end = buffer + sizeof(buffer);
+        char* first = writeDec(end, decimals + 1);
+
+        if ( decimals > 0 ) { // make room for the point
+            char* point = end - decimals - 1;
+            memmove(first - 1, first, point + 1 - first);
+            *point = '.';
+            first--;
+        }
+
+        return QString::fromLatin1(first, end - first);
+    }
+
+    quint64 UInt256::toUInt64() const {
+        return fLimbs[0];
+    }
+
+    bool UInt256::fitsUInt64() const {
+        return (fLimbs[1] | fLimbs[2] | fLimbs[3]) == 0;
+    }
+
+    bool UInt256::isZero() const {
+        return (fLimbs[0] | fLimbs[1] | fLimbs[2] | fLimbs[3]) == 0;
+    }
+
+    bool UInt256::bit(int index) const {
+        return ( fLimbs[index / 64] >> (index % 64) ) & 1;
+    }
+
+    int UInt256::bitLength() const {
+        for ( int i = 3; i >= 0; i-- ) {
+            if ( fLimbs[i] != 0 ) {
+                int bits = 64;
+                while ( ( fLimbs[i] >> (bits - 1) ) == 0 ) {
+                    bits--;
+                }
+                return i * 64 + bits;
+            }
+        }
+
+        return 0;
+    }
+
+    quint64 UInt256::limb(int index) const {
+        return fLimbs[index];
+    }
+
+    const UInt256 UInt256::operator+(const UInt256& other) const {
+        UInt256 result(*this);
+        result += other;
+        return result;
+    }
+
+    const UInt256 UInt256::operator-(const UInt256& other) const {
+        UInt256 result(*this);
+        result -= other;
+        return result;
+    }
+
+    // truncated to the low 256 bits, only the partial products that land there are computed
+    const UInt256 UInt256::operator*(const UInt256& other) const {
+        UInt256 result;
+        for ( int i = 0; i < 4; i++ ) {
+            if ( fLimbs[i] == 0 ) {
+                continue;
+            }
+
+            quint64 carry = 0;
+            for ( int j = 0; i + j < 4; j++ ) {
+                quint64 hi, lo;
+                mul64(fLimbs[i], other.fLimbs[j], hi, lo);
+                lo += carry;
+                hi += lo < carry;
+                result.fLimbs[i + j] += lo;
+                hi += result.fLimbs[i + j] < lo;
+                carry = hi;
+            }
+        }
+
+        return result;
+    }
+
+    const UInt256 UInt256::operator/(const UInt256& other) const {
+        UInt256 quotient, remainder;
+        divMod(*this, other, quotient, remainder);
+        return quotient;
+    }
+
+    const UInt256 UInt256::operator%(const UInt256& other) const {
+        UInt256 quotient, remainder;
+        divMod(*this, other, quotient, remainder);
+        return remainder;
+    }
+
+    const UInt256 UInt256::operator-() const {
+        return UInt256() - *this;
+    }
+
+    const UInt256 UInt256::operator~() const {
+        UInt256 result;
+        for ( int i = 0; i < 4; i++ ) {
+            result.fLimbs[i] = ~fLimbs[i];
+        }
+        return result;
+    }
+
+    const UInt256 UInt256::operator<<(int shift) const {
+        UInt256 result;
+        if ( shift >= 256 || shift < 0 ) {
+            return result;
+        }
+
+        const int limbs = shift / 64;
+        const int bits = shift % 64;
+        for ( int i = 3; i >= limbs; i-- ) {
+            result.fLimbs[i] = fLimbs[i - limbs] << bits;
+            if ( bits > 0 && i - limbs > 0 ) {
+                result.fLimbs[i] |= fLimbs[i - limbs - 1] >> (64 - bits);
+            }
+        }
+
+        return result;
+    }
+
+    const UInt256 UInt256::operator>>(int shift) const {
+        UInt256 result;
+        if ( shift >= 256 || shift < 0 ) {
+            return result;
+        }
+
+        const int limbs = shift / 64;
+        const int bits = shift % 64;
+        for ( int i = 0; i + limbs < 4; i++ ) {
+            result.fLimbs[i] = fLimbs[i + limbs] >> bits;
+            if ( bits > 0 && i + limbs < 3 ) {
+                result.fLimbs[i] |= fLimbs[i + limbs + 1] << (64 - bits);
+            }
+        }
+
+        return result;
+    }
+
+    UInt256& UInt256::operator+=(const UInt256& other) {
+        quint64 carry = 0;
+        for ( int i = 0; i < 4; i++ ) {
+            const quint64 sum = fLimbs[i] + other.fLimbs[i];
+            const quint64 total = sum + carry;
+            carry = ( sum < fLimbs[i] ) || ( total < sum ) ? 1 : 0;
+            fLimbs[i] = total;
+        }
+        return *this;
+    }
+
+    UInt256& UInt256::operator-=(const UInt256& other) {
+        quint64 borrow = 0;
+        for ( int i = 0; i < 4; i++ ) {
+            const quint64 diff = fLimbs[i] - other.fLimbs[i];
+            const quint64 total = diff - borrow;
+            borrow = ( fLimbs[i] < other.fLimbs[i] ) || ( diff < borrow ) ? 1 : 0;
+            fLimbs[i] = total;
+        }
+        return *this;
+    }
+
+    UInt256& UInt256::operator*=(const UInt256& other) {
+        *this = *this * other;
+        return *this;
+    }
+
+    UInt256& UInt256::operator/=(const UInt256& other) {
+        *this = *this / other;
+        return *this;
+    }
+
+    bool UInt256::operator==(const UInt256& other) const {
+        return fLimbs[0] == other.fLimbs[0] && fLimbs[1] == other.fLimbs[1] &&
+               fLimbs[2] == other.fLimbs[2] && fLimbs[3] == other.fLimbs[3];
+    }
+
+    bool UInt256::operator!=(const UInt256& other) const {
+        return !(*this == other);
+    }
+
+    bool UInt256::operator<(const UInt256& other) const {
+        for ( int i = 3; i >= 0; i-- ) {
+            if ( fLimbs[i] != other.fLimbs[i] ) {
+                return fLimbs[i] < other.fLimbs[i];
+            }
+        }
+        return false;
+    }
+
+    bool UInt256::operator>(const UInt256& other) const {
+        return other < *this;
+    }
+
+    bool UInt256::operator<=(const UInt256& other) const {
+        return !(other < *this);
+    }
+
+    bool UInt256::operator>=(const UInt256& other) const {
+        return !(*this < other);
+    }
+
+    int UInt256::liveLimbs() const {
+        int live = 4;
+        while ( live > 0 && fLimbs[live - 1] == 0 ) {
+            live--;
+        }
+        return live;
+    }
+
+    quint64 UInt256::mulAdd(quint64 factor, quint64 addend) {
+        quint64 carry = addend;
+        for ( int i = 0; i < 4; i++ ) {
+            quint64 hi, lo;
+            mul64(fLimbs[i], factor, hi, lo);
+            lo += carry;
+            hi += lo < carry;
+            fLimbs[i] = lo;
+            carry = hi;
+        }
+        return carry;
+    }
+
+    quint64 UInt256::divSmall(quint64 divisor) {
+        int live = liveLimbs();
+        return divSmall(divisor, live);
+    }
+
+    quint64 UInt256::divSmall(quint64 divisor, int& live) {
+        quint64 remainder = 0;
+        for ( int i = live - 1; i >= 0; i-- ) {
+            fLimbs[i] = div128(remainder, fLimbs[i], divisor, remainder);
+        }
+
+        while ( live > 0 && fLimbs[live - 1] == 0 ) {
+            live--;
+        }
+        return remainder;
+    }
+
+    // 10^19 chunks peeled off the live limbs only, the last limb goes out unpadded
+    char* UInt256::writeDec(char* end, int minDigits) const {
+        UInt256 value(*this);
+        int live = value.liveLimbs();
+        char* pos = end;
+
+        while ( live > 1 ) {
+            pos = writeChunk(pos, value.divSmall(DEC_CHUNK, live));
+        }
+
+        quint64 top = value.fLimbs[0];
+        if ( top >= DEC_CHUNK ) {
+            pos = writeChunk(pos, top % DEC_CHUNK);
+            top /= DEC_CHUNK;
+        }
+
+        while ( top >= 100 ) {
+            const int pair = (int)(top % 100) * 2;
+            top /= 100;
+            *--pos = sDigitPairs[pair + 1];
+            *--pos = sDigitPairs[pair];
+        }
+
+        if ( top >= 10 ) {
+            *--pos = sDigitPairs[top * 2 + 1];
+            *--pos = sDigitPairs[top * 2];
+        } else if ( top > 0 || pos == end ) {
+            *--pos = (char)('0' + top);
+        }
+
+        while ( end - pos < minDigits ) {
+            *--pos = '0';
+        }
+        return pos;
+    }
+
+}
@@ -0,0 +1,93 @@
+/*
+    This file is part of dbixwall.
+    dbixwall is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    dbixwall is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with dbixwall. If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file uint256.h
+ * @date 2026
+ *
+ * Fixed width 256 bit unsigned integer header
+ */
+
+#ifndef UINT256_H
+#define UINT256_H
+
+#include <QtGlobal>
+#include <QString>
+
+namespace Dbixwall {
+
+    // 10^exponent for 0 <= exponent <= 19, usable in constant expressions
+    Q_DECL_CONSTEXPR inline quint64 powerOfTen(int exponent) {
+        return exponent <= 0 ? Q_UINT64_C(1) : Q_UINT64_C(10) * powerOfTen(exponent - 1);
+    }
+
+    // stack allocated 256 bit unsigned integer, four 64 bit limbs with the least
+    // significant first. Arithmetic wraps modulo 2^256 like the EVM does, so two's
+    // complement negation gives us signed ABI values for free.
+    class UInt256
+    {
+    public:
+        UInt256();
+        UInt256(quint64 value);
+
+        static const UInt256 fromHex(const QString& hex, bool* ok = 0); // optional 0x prefix
+        static const UInt256 fromHex(const char* data, int size, bool* ok = 0);
+        static const UInt256 fromDec(const QString& dec, bool* ok = 0);
+        static const UInt256 fromDecimal(const QString& text, int decimals, bool* ok = 0); // "1.5" -> 15 * 10^(decimals - 1)
+        static const UInt256 max();
+        static void divMod(const UInt256& dividend, const UInt256& divisor, UInt256& quotient, UInt256& remainder);
+
+        const QString toHex() const; // no leading zeros, "0" for zero
+        const QString toHex(int width) const; // zero padded
+        const QString to0xHex() const;
+        const QString toDec() const;
+        const QString toDec(int decimals) const; // fixed point, always with all the decimals
+        quint64 toUInt64() const; // low 64 bits
+        bool fitsUInt64() const;
+        bool isZero() const;
+        bool bit(int index) const;
+        int bitLength() const;
+        quint64 limb(int index) const;
+
+        const UInt256 operator+(const UInt256& other) const;
+        const UInt256 operator-(const UInt256& other) const;
+        const UInt256 operator*(const UInt256& other) const;
+        const UInt256 operator/(const UInt256& other) const;
+        const UInt256 operator%(const UInt256& other) const;
+        const UInt256 operator-() const;
+        const UInt256 operator~() const;
+        const UInt256 operator<<(int shift) const;
+        const UInt256 operator>>(int shift) const;
+        UInt256& operator+=(const UInt256& other);
+        UInt256& operator-=(const UInt256& other);
+        UInt256& operator*=(const UInt256& other);
+        UInt256& operator/=(const UInt256& other);
+
+        bool operator==(const UInt256& other) const;
+        bool operator!=(const UInt256& other) const;
+        bool operator<(const UInt256& other) const;
+        bool operator>(const UInt256& other) const;
+        bool operator<=(const UInt256& other) const;
+        bool operator>=(const UInt256& other) const;
+    private:
+        quint64 fLimbs[4];
+
+        int liveLimbs() const;
+        quint64 mulAdd(quint64 factor, quint64 addend); // in place, returns the overflowing limb
+        quint64 divSmall(quint64 divisor); // in place, returns the remainder
+        quint64 divSmall(quint64 divisor, int& live); // same over the live limbs only
+        char* writeDec(char* end, int minDigits) const; // backwards from end, returns the first digit
+    };
+
+}
+
+#endif // UINT256_H
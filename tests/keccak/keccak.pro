@@ -0,0 +1,15 @@
+QT += testlib
+QT -= gui
+
+CONFIG += testcase console
+CONFIG -= app_bundle
+
+TARGET = tst_keccak
+
+INCLUDEPATH += ../../src
+DEPENDPATH += ../../src
+
+SOURCES += tst_keccak.cpp \
+    ../../src/dubaicoin/keccak.cpp
+
+HEADERS += ../../src/dubaicoin/keccak.h
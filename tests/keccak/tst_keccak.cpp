@@ -0,0 +1,215 @@
+/*
+    This file is part of dbixwall.
+    dbixwall is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    dbixwall is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with dbixwall. If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file tst_keccak.cpp
+ * @date 2026
+ *
+ * Keccak-256 known answers for the scalar and 4-way kernels, and their throughput
+ */
+
+#include <QtTest>
+#include "dubaicoin/keccak.h"
+
+using Dubaicoin::Keccak256;
+
+class TestKeccak : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void scalar_data();
+    void scalar();
+    void incremental_data();
+    void incremental();
+    void fourWay_data();
+    void fourWay();
+    void fourWayLanes();
+    void hashMany();
+    void scalarThroughput_data();
+    void scalarThroughput();
+    void fourWayThroughput_data();
+    void fourWayThroughput();
+private:
+    static void knownAnswers();
+    static const QByteArray hash4(const QByteArray& data, int lane);
+};
+
+void TestKeccak::initTestCase() {
+    qDebug("4-way kernel: %s", Keccak256::kernelName());
+}
+
+void TestKeccak::knownAnswers() {
+    QTest::addColumn<QByteArray>("message");
+    QTest::addColumn<QByteArray>("hash");
+
+    QTest::newRow("empty") << QByteArray()
+        << QByteArray("c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+    QTest::newRow("transfer selector") << QByteArray("transfer(address,uint256)")
+        << QByteArray("a9059cbb2ab09eb219583f4a59a5d0623ade346d962bcd4e46b11da047c9049b");
+    QTest::newRow("eip155 signing data") << QByteArray::fromHex("ec098504a817c800825208943535353535353535353535353535353535353535880de0b6b3a764000080018080")
+        << QByteArray("daf5a779ae972f972197303d7b574746c7ef83eadac0f2791ad23db92e4c8e53");
+    QTest::newRow("one rate") << QByteArray(Keccak256::RATE, 'a') // padding spills into a second block
+        << QByteArray("a6c4d403279fe3e0af03729caada8374b5ca54d8065329a3ebcaeb4b60aa386e");
+    QTest::newRow("three blocks") << QByteArray("abc").repeated(100)
+        << QByteArray("0b4690e744c6ff5f43ac16817124efeaa0b3b3ff9bc26d092984bbb14badeaf5");
+}
+
+void TestKeccak::scalar_data() {
+    knownAnswers();
+}
+
+void TestKeccak::scalar() {
+    QFETCH(QByteArray, message);
+    QFETCH(QByteArray, hash);
+
+    QCOMPARE(Keccak256::hash(message).toHex(), hash);
+}
+
+void TestKeccak::incremental_data() {
+    knownAnswers();
+}
+
+// byte by byte through the buffer, then again on the same instance after digest
+void TestKeccak::incremental() {
+    QFETCH(QByteArray, message);
+    QFETCH(QByteArray, hash);
+
+    Keccak256 keccak;
+    for ( int round = 0; round < 2; round++ ) {
+        for ( int i = 0; i < message.size(); i++ ) {
+            keccak.update((const uchar*)message.constData() + i, 1);
+        }
+        QCOMPARE(keccak.digest().toHex(), hash);
+    }
+}
+
+void TestKeccak::fourWay_data() {
+    knownAnswers();
+}
+
+void TestKeccak::fourWay() {
+    QFETCH(QByteArray, message);
+    QFETCH(QByteArray, hash);
+
+    for ( int lane = 0; lane < 4; lane++ ) {
+        QCOMPARE(hash4(message, lane).toHex(), hash);
+    }
+}
+
+// different messages and sizes in each lane
+void TestKeccak::fourWayLanes() {
+    const QByteArray messages[4] = {
+        QByteArray(),
+        QByteArray("transfer(address,uint256)"),
+        QByteArray(Keccak256::RATE, 'a'),
+        QByteArray("abc").repeated(100)
+    };
+    const uchar* in[4];
+    int size[4];
+    uchar* out[4];
+    QByteArray hashes[4];
+    for ( int k = 0; k < 4; k++ ) {
+        in[k] = (const uchar*)messages[k].constData();
+        size[k] = messages[k].size();
+        hashes[k] = QByteArray(Keccak256::HASH_SIZE, '\0');
+        out[k] = (uchar*)hashes[k].data();
+    }
+
+    Keccak256::hash4(in, size, out);
+    for ( int k = 0; k < 4; k++ ) {
+        QCOMPARE(hashes[k], Keccak256::hash(messages[k]));
+    }
+}
+
+// short last group included
+void TestKeccak::hashMany() {
+    QList<QByteArray> messages;
+    for ( int i = 0; i < 7; i++ ) {
+        messages.append(QByteArray(i * 40, char('a' + i)));
+    }
+
+    const QList<QByteArray> hashes = Keccak256::hashMany(messages);
+    QCOMPARE(hashes.size(), messages.size());
+    for ( int i = 0; i < messages.size(); i++ ) {
+        QCOMPARE(hashes.at(i), Keccak256::hash(messages.at(i)));
+    }
+}
+
+void TestKeccak::scalarThroughput_data() {
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("32 bytes") << 32; // hash of a hash, topics
+    QTest::newRow("135 bytes") << Keccak256::RATE - 1; // signed transfer sized, one block
+    QTest::newRow("1 KiB") << 1024;
+}
+
+// the same four messages as fourWayThroughput, one after another
+void TestKeccak::scalarThroughput() {
+    QFETCH(int, size);
+
+    const QByteArray message(size, 'x');
+    uchar out[4][Keccak256::HASH_SIZE];
+    QBENCHMARK {
+        for ( int k = 0; k < 4; k++ ) {
+            Keccak256::hash((const uchar*)message.constData(), size, out[k]);
+        }
+    }
+    QCOMPARE(QByteArray((const char*)out[3], Keccak256::HASH_SIZE), Keccak256::hash(message));
+}
+
+void TestKeccak::fourWayThroughput_data() {
+    scalarThroughput_data();
+}
+
+void TestKeccak::fourWayThroughput() {
+    QFETCH(int, size);
+
+    const QByteArray message(size, 'x');
+    const uchar* in[4];
+    int sizes[4];
+    uchar result[4][Keccak256::HASH_SIZE];
+    uchar* out[4];
+    for ( int k = 0; k < 4; k++ ) {
+        in[k] = (const uchar*)message.constData();
+        sizes[k] = size;
+        out[k] = result[k];
+    }
+
+    QBENCHMARK {
+        Keccak256::hash4(in, sizes, out);
+    }
+    QCOMPARE(QByteArray((const char*)result[3], Keccak256::HASH_SIZE), Keccak256::hash(message));
+}
+
+// the message in the given lane, the other lanes busy with something else
+const QByteArray TestKeccak::hash4(const QByteArray& data, int lane) {
+    const QByteArray filler("filler");
+    const uchar* in[4];
+    int size[4];
+    uchar* out[4];
+    QByteArray hashes[4];
+    for ( int k = 0; k < 4; k++ ) {
+        const QByteArray& message = k == lane ? data : filler;
+        in[k] = (const uchar*)message.constData();
+        size[k] = message.size();
+        hashes[k] = QByteArray(Keccak256::HASH_SIZE, '\0');
+        out[k] = (uchar*)hashes[k].data();
+    }
+
+    Keccak256::hash4(in, size, out);
+    return hashes[lane];
+}
+
+QTEST_APPLESS_MAIN(TestKeccak)
+
+#include "tst_keccak.moc"
@@ -0,0 +1,5 @@
+TEMPLATE = subdirs
+
+SUBDIRS += tx \
+    uint256 \
+    keccak
@@ -0,0 +1,90 @@
+/*
+    This file is part of dbixwall.
+    dbixwall is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    dbixwall is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with dbixwall. If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file tst_tx.cpp
+ * @date 2026
+ *
+ * Tx RLP encoding against the EIP-155 example transaction
+ */
+
+#include <QtTest>
+#include "dubaicoin/tx.h"
+
+using Dubaicoin::Tx;
+
+// nonce 9, 20 gwei, 21000 gas, 1 dbix to 0x3535..., signed for chain id 1
+static const char* const SIGNED_RLP = "f86c098504a817c800825208943535353535353535353535353535353535353535880de0b6b3a7640000"
+                                      "8025a028ef61340bd939bc2195fe537567866003e1a15d3c71ff63e1590620aa636276"
+                                      "a067cbe9d8997f761aecb703304b3800ccf555c9f3dc64214b297fb1966a3b6d83";
+static const char* const SIGNED_HASH = "33469b22e9f636356c4160a87eb19df52b7412e8eac32a4a55ffe88ea8350788";
+static const char* const UNSIGNED_RLP = "e9098504a817c800825208943535353535353535353535353535353535353535880de0b6b3a764000080";
+static const char* const UNSIGNED_HASH = "f9e36c28c8cb35adba138005c02ab7aa7fbcd891f3139cb2eeed052a51cd2713";
+
+class TestTx : public QObject
+{
+    Q_OBJECT
+private slots:
+    void encodeUnsigned();
+    void encodeSigned();
+    void decode();
+    void decodeInvalid();
+private:
+    static const Tx exampleTx();
+};
+
+void TestTx::encodeUnsigned() {
+    const Tx tx = exampleTx();
+
+    QCOMPARE(tx.encodeRLP(false), QString(UNSIGNED_RLP));
+    QCOMPARE(tx.signingHash().toHex(), QByteArray(UNSIGNED_HASH));
+}
+
+void TestTx::encodeSigned() {
+    Tx tx = exampleTx();
+    tx.sign(37, QByteArray::fromHex("28ef61340bd939bc2195fe537567866003e1a15d3c71ff63e1590620aa636276").toStdString(),
+                QByteArray::fromHex("67cbe9d8997f761aecb703304b3800ccf555c9f3dc64214b297fb1966a3b6d83").toStdString());
+
+    QCOMPARE(tx.encodeRLP(), QString(SIGNED_RLP));
+    QCOMPARE(tx.hash().toHex(), QByteArray(SIGNED_HASH));
+}
+
+void TestTx::decode() {
+    bool ok = false;
+    const Tx tx = Tx::fromRLPHex("0x" + QString(SIGNED_RLP), &ok);
+    QVERIFY(ok);
+
+    QCOMPARE(tx.nonce(), Q_UINT64_C(9));
+    QCOMPARE(tx.toStr(), QString("0x3535353535353535353535353535353535353535"));
+    QCOMPARE(tx.gasStr(), QString("21000"));
+    QVERIFY(!tx.hasData());
+    QCOMPARE(tx.encodeRLP(), QString(SIGNED_RLP));
+    QCOMPARE(tx.hash().toHex(), QByteArray(SIGNED_HASH));
+}
+
+void TestTx::decodeInvalid() {
+    bool ok = true;
+    Tx::fromRLPHex(QString(SIGNED_RLP).left(40), &ok); // truncated
+    QVERIFY(!ok);
+
+    ok = true;
+    Tx::fromRLPHex(QString(SIGNED_RLP) + "00", &ok); // trailing garbage
+    QVERIFY(!ok);
+}
+
+const Tx TestTx::exampleTx() {
+    return Tx(QString(), "0x3535353535353535353535353535353535353535", "1", 9, "21000", "0.00000002");
+}
+
+QTEST_APPLESS_MAIN(TestTx)
+
+#include "tst_tx.moc"
@@ -0,0 +1,32 @@
+QT += widgets network testlib
+
+CONFIG += testcase console
+CONFIG -= app_bundle
+
+TARGET = tst_tx
+
+INCLUDEPATH += ../../src
+DEPENDPATH += ../../src
+
+SOURCES += tst_tx.cpp \
+    ../../src/types.cpp \
+    ../../src/dbixlog.cpp \
+    ../../src/helpers.cpp \
+    ../../src/transactionstore.cpp \
+    ../../src/uint256.cpp \
+    ../../src/fixeddecimal.cpp \
+    ../../src/hexcodec.cpp \
+    ../../src/dubaicoin/keccak.cpp \
+    ../../src/dubaicoin/rlp.cpp \
+    ../../src/dubaicoin/tx.cpp
+
+HEADERS += ../../src/types.h \
+    ../../src/dbixlog.h \
+    ../../src/helpers.h \
+    ../../src/transactionstore.h \
+    ../../src/uint256.h \
+    ../../src/fixeddecimal.h \
+    ../../src/hexcodec.h \
+    ../../src/dubaicoin/keccak.h \
+    ../../src/dubaicoin/rlp.h \
+    ../../src/dubaicoin/tx.h
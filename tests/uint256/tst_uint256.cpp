@@ -0,0 +1,330 @@
+/*
+    This file is part of dbixwall.
+    dbixwall is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    dbixwall is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with dbixwall. If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file tst_uint256.cpp
+ * @date 2026
+ *
+ * UInt256 conversion checks and micro-benchmarks, run with -median for stable numbers.
+ * The *Baseline benchmarks time the conversions UInt256 had before the table and
+ * chunk kernels, the same inputs go through both.
+ */
+
+#include <QtTest>
+#include <cstring>
+#include "uint256.h"
+
+using Dbixwall::UInt256;
+
+// *************************** Baseline **************************** //
+
+// the old kernels on plain limbs, least significant first
+static int baselineHexValue(ushort c) {
+    if ( c >= '0' && c <= '9' ) return c - '0';
+    if ( c >= 'a' && c <= 'f' ) return c - 'a' + 10;
+    if ( c >= 'A' && c <= 'F' ) return c - 'A' + 10;
+    return -1;
+}
+
+// one nibble at a time through QChar
+static bool baselineFromHex(const QString& hex, quint64* limbs) {
+    memset(limbs, 0, 4 * sizeof(quint64));
+    int start = ( hex.startsWith("0x") || hex.startsWith("0X") ) ? 2 : 0;
+    while ( start < hex.length() && hex.at(start) == '0' ) {
+        start++;
+    }
+
+    if ( hex.length() - start > 64 ) {
+        return false;
+    }
+
+    int shift = 0;
+    for ( int i = hex.length() - 1; i >= start; i-- ) {
+        const int nibble = baselineHexValue(hex.at(i).unicode());
+        if ( nibble < 0 ) {
+            return false;
+        }
+
+        limbs[shift / 64] |= (quint64)nibble << (shift % 64);
+        shift += 4;
+    }
+
+    return true;
+}
+
+#ifdef __SIZEOF_INT128__
+static quint64 baselineMulAdd(quint64* limbs, quint64 factor, quint64 addend) {
+    quint64 carry = addend;
+    for ( int i = 0; i < 4; i++ ) {
+        const unsigned __int128 product = (unsigned __int128)limbs[i] * factor + carry;
+        limbs[i] = (quint64)product;
+        carry = (quint64)(product >> 64);
+    }
+    return carry;
+}
+
+static quint64 baselineDivSmall(quint64* limbs, quint64 divisor) {
+    quint64 remainder = 0;
+    for ( int i = 3; i >= 0; i-- ) {
+        const unsigned __int128 dividend = ((unsigned __int128)remainder << 64) | limbs[i];
+        limbs[i] = (quint64)(dividend / divisor);
+        remainder = (quint64)(dividend % divisor);
+    }
+    return remainder;
+}
+
+// 19 digits at a time through QChar
+static bool baselineFromDec(const QString& dec, quint64* limbs) {
+    memset(limbs, 0, 4 * sizeof(quint64));
+    const int length = dec.length();
+    int pos = 0;
+    int chunkDigits = length % 19;
+    if ( chunkDigits == 0 ) {
+        chunkDigits = 19;
+    }
+
+    while ( pos < length ) {
+        quint64 chunk = 0;
+        quint64 factor = 1;
+        for ( int i = 0; i < chunkDigits; i++ ) {
+            const ushort c = dec.at(pos + i).unicode();
+            if ( c < '0' || c > '9' ) {
+                return false;
+            }
+            chunk = chunk * 10 + (c - '0');
+            factor *= 10;
+        }
+
+        if ( baselineMulAdd(limbs, factor, chunk) != 0 ) {
+            return false;
+        }
+
+        pos += chunkDigits;
+        chunkDigits = 19;
+    }
+
+    return true;
+}
+
+// 10^19 chunks over all four limbs, then one digit at a time
+static const QString baselineToDec(const quint64* source) {
+    quint64 limbs[4];
+    memcpy(limbs, source, sizeof(limbs));
+    char buffer[80];
+    int pos = 80;
+
+    bool zero = false;
+    do {
+        quint64 chunk = baselineDivSmall(limbs, Q_UINT64_C(10000000000000000000));
+        zero = (limbs[0] | limbs[1] | limbs[2] | limbs[3]) == 0;
+        for ( int i = 0; i < 19 && ( !zero || chunk > 0 || i == 0 ); i++ ) {
+            buffer[--pos] = (char)('0' + chunk % 10);
+            chunk /= 10;
+        }
+    } while ( !zero );
+
+    return QString::fromLatin1(buffer + pos, 80 - pos);
+}
+#endif
+
+static bool sameLimbs(const quint64* limbs, const UInt256& value) {
+    for ( int i = 0; i < 4; i++ ) {
+        if ( limbs[i] != value.limb(i) ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// *************************** TestUInt256 **************************** //
+
+class TestUInt256 : public QObject
+{
+    Q_OBJECT
+private slots:
+    void weiHex_data();
+    void weiHex();
+    void wideDivisor();
+    void emptyInput();
+    void fromHex();
+    void fromHexBaseline();
+    void toHex();
+    void fromDec();
+    void fromDecBaseline();
+    void toDec();
+    void toDecBaseline();
+    void toDecimals();
+    void multiply();
+    void divMod();
+};
+
+// same values as tests/conversions.txt
+void TestUInt256::weiHex_data() {
+    QTest::addColumn<QString>("dbix");
+    QTest::addColumn<QString>("weiHex");
+
+    QTest::newRow("4") << "4" << "0x3782dace9d900000";
+    QTest::newRow("213987325409") << "213987325409" << "0x2b36e2abaa3d84c12d2e40000";
+    QTest::newRow("0") << "0" << "0x0";
+    QTest::newRow("0.1") << "0.1" << "0x16345785d8a0000";
+    QTest::newRow("1 wei") << "0.000000000000000001" << "0x1";
+    QTest::newRow("8.3") << "8.3" << "0x732f860653be0000";
+}
+
+void TestUInt256::weiHex() {
+    QFETCH(QString, dbix);
+    QFETCH(QString, weiHex);
+
+    bool ok = false;
+    const UInt256 wei = UInt256::fromDecimal(dbix, 18, &ok);
+    QVERIFY(ok);
+    QCOMPARE(wei.to0xHex(), weiHex);
+    QVERIFY(UInt256::fromHex(weiHex) == wei);
+}
+
+// divisors above 2^255 overflow the shifted remainder
+void TestUInt256::wideDivisor() {
+    const UInt256 divisor = UInt256::fromHex("0xaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa");
+    UInt256 quotient;
+    UInt256 remainder;
+    UInt256::divMod(UInt256::max(), divisor, quotient, remainder);
+    QVERIFY(quotient == UInt256(1));
+    QCOMPARE(remainder.to0xHex(), QString("0x5555555555555555555555555555555555555555555555555555555555555555"));
+
+    const UInt256 top = UInt256::fromHex("0x8000000000000000000000000000000000000000000000000000000000003039");
+    QVERIFY(UInt256::max() / top == UInt256(1));
+    QVERIFY(UInt256::max() % top == UInt256::max() - top);
+}
+
+void TestUInt256::emptyInput() {
+    bool ok = true;
+    UInt256::fromDec("", &ok);
+    QVERIFY(!ok);
+
+    ok = true;
+    UInt256::fromDecimal("", 18, &ok);
+    QVERIFY(!ok);
+
+    ok = true;
+    UInt256::fromDecimal(".", 18, &ok);
+    QVERIFY(!ok);
+
+    ok = false;
+    QVERIFY(UInt256::fromDecimal(".5", 18, &ok) == UInt256::fromDec("500000000000000000") && ok);
+}
+
+void TestUInt256::fromHex() {
+    const QString hex = UInt256::max().to0xHex();
+    UInt256 result;
+    QBENCHMARK {
+        result = UInt256::fromHex(hex);
+    }
+    QVERIFY(result == UInt256::max());
+}
+
+void TestUInt256::fromHexBaseline() {
+    const QString hex = UInt256::max().to0xHex();
+    quint64 limbs[4];
+    QBENCHMARK {
+        baselineFromHex(hex, limbs);
+    }
+    QVERIFY(sameLimbs(limbs, UInt256::max()));
+}
+
+void TestUInt256::toHex() {
+    const UInt256 value = UInt256::max();
+    QString result;
+    QBENCHMARK {
+        result = value.to0xHex();
+    }
+    QCOMPARE(result.size(), 66);
+}
+
+void TestUInt256::fromDec() {
+    const QString dec = UInt256::max().toDec();
+    UInt256 result;
+    QBENCHMARK {
+        result = UInt256::fromDec(dec);
+    }
+    QVERIFY(result == UInt256::max());
+}
+
+void TestUInt256::fromDecBaseline() {
+#ifdef __SIZEOF_INT128__
+    const QString dec = UInt256::max().toDec();
+    quint64 limbs[4];
+    QBENCHMARK {
+        baselineFromDec(dec, limbs);
+    }
+    QVERIFY(sameLimbs(limbs, UInt256::max()));
+#else
+    QSKIP("baseline needs 128 bit integers");
+#endif
+}
+
+void TestUInt256::toDec() {
+    const UInt256 value = UInt256::max();
+    QString result;
+    QBENCHMARK {
+        result = value.toDec();
+    }
+    QCOMPARE(result, QString("115792089237316195423570985008687907853269984665640564039457584007913129639935"));
+}
+
+void TestUInt256::toDecBaseline() {
+#ifdef __SIZEOF_INT128__
+    const quint64 limbs[4] = { ~Q_UINT64_C(0), ~Q_UINT64_C(0), ~Q_UINT64_C(0), ~Q_UINT64_C(0) };
+    QString result;
+    QBENCHMARK {
+        result = baselineToDec(limbs);
+    }
+    QCOMPARE(result, UInt256::max().toDec());
+#else
+    QSKIP("baseline needs 128 bit integers");
+#endif
+}
+
+// the wallet's common case, a balance with 18 decimals
+void TestUInt256::toDecimals() {
+    const UInt256 value = UInt256::fromHex("0x2b36e2abaa3d84c12d2e40000");
+    QString result;
+    QBENCHMARK {
+        result = value.toDec(18);
+    }
+    QCOMPARE(result, QString("213987325409.000000000000000000"));
+}
+
+void TestUInt256::multiply() {
+    const UInt256 a = UInt256::fromHex("0x2b36e2abaa3d84c12d2e40000");
+    const UInt256 b = UInt256::fromDec("1000000000000000000");
+    UInt256 result;
+    QBENCHMARK {
+        result = a * b;
+    }
+    QVERIFY(result / b == a);
+}
+
+void TestUInt256::divMod() {
+    const UInt256 dividend = UInt256::max();
+    const UInt256 divisor = UInt256::fromHex("0x2b36e2abaa3d84c12d2e40000");
+    UInt256 quotient;
+    UInt256 remainder;
+    QBENCHMARK {
+        UInt256::divMod(dividend, divisor, quotient, remainder);
+    }
+    QVERIFY(quotient * divisor + remainder == dividend);
+    QVERIFY(remainder < divisor);
+}
+
+QTEST_APPLESS_MAIN(TestUInt256)
+
+#include "tst_uint256.moc"
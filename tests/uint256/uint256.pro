@@ -0,0 +1,15 @@
+QT += testlib
+QT -= gui
+
+CONFIG += testcase console
+CONFIG -= app_bundle
+
+TARGET = tst_uint256
+
+INCLUDEPATH += ../../src
+DEPENDPATH += ../../src
+
+SOURCES += tst_uint256.cpp \
+    ../../src/uint256.cpp
+
+HEADERS += ../../src/uint256.h